@@ -25,6 +25,62 @@ typedef enum {
   emnapi_buffer = -2,
 } emnapi_memory_view_type;
 
+typedef enum {
+  emnapi_value_int32,
+  emnapi_value_uint32,
+  emnapi_value_double,
+  emnapi_value_bool,
+  emnapi_value_string_utf8,
+} emnapi_value_descriptor_type;
+
+typedef struct {
+  emnapi_value_descriptor_type type;
+  union {
+    int32_t int32;
+    uint32_t uint32;
+    double number;
+    bool boolean;
+    struct {
+      const char* str;
+      size_t length;
+    } utf8;
+  } value;
+} emnapi_value_descriptor;
+
+typedef void (*emnapi_typed_callback)(void);
+
+typedef enum {
+  emnapi_field_int8,
+  emnapi_field_uint8,
+  emnapi_field_int16,
+  emnapi_field_uint16,
+  emnapi_field_int32,
+  emnapi_field_uint32,
+  emnapi_field_float,
+  emnapi_field_double,
+  emnapi_field_bool,
+} emnapi_field_type;
+
+typedef struct {
+  const char* utf8name;
+  size_t offset;
+  emnapi_field_type type;
+  napi_property_attributes attributes;
+} emnapi_field_descriptor;
+
+typedef struct {
+  uint32_t handle_count;
+  uint32_t peak_handle_count;
+  uint32_t persistent_handle_count;
+  uint32_t scope_depth;
+  uint32_t peak_scope_depth;
+  uint32_t reference_count;
+  uint32_t deferred_count;
+  uint32_t finalizer_count;
+  uint32_t pending_finalizer_count;
+  uint32_t handle_capacity;
+} emnapi_runtime_stats;
+
 EXTERN_C_START
 
 EMNAPI_EXTERN int emnapi_is_support_weakref();
@@ -76,6 +132,71 @@ napi_status emnapi_get_memory_address(napi_env env,
                                       emnapi_ownership* ownership,
                                       bool* runtime_allocated);
 
+EMNAPI_EXTERN
+napi_status emnapi_create_values(napi_env env,
+                                 size_t count,
+                                 const emnapi_value_descriptor* descriptors,
+                                 napi_value* result);
+
+EMNAPI_EXTERN
+napi_status emnapi_get_named_properties(napi_env env,
+                                        napi_value object,
+                                        size_t count,
+                                        const char* const* keys,
+                                        napi_value* values);
+
+EMNAPI_EXTERN
+napi_status emnapi_set_named_properties(napi_env env,
+                                        napi_value object,
+                                        size_t count,
+                                        const char* const* keys,
+                                        const napi_value* values);
+
+// strings in [begin, begin + size) must never be modified,
+// calling this again also releases the interned keys,
+// the cache belongs to the module's memory and is shared by its envs
+EMNAPI_EXTERN
+napi_status emnapi_enable_property_key_cache(napi_env env,
+                                             const void* begin,
+                                             size_t size);
+
+// the key is interned, the result is valid at least until
+// the outermost handle scope is closed
+EMNAPI_EXTERN
+napi_status emnapi_create_property_key_utf8(napi_env env,
+                                            const char* str,
+                                            size_t length,
+                                            napi_value* result);
+
+// signature is "r(params)", r is one of i u f d v, params are i u f d or p,
+// p passes `data`. cb is called without an env or a handle scope.
+EMNAPI_EXTERN
+napi_status emnapi_create_function_typed(napi_env env,
+                                         const char* utf8name,
+                                         const char* signature,
+                                         emnapi_typed_callback cb,
+                                         void* data,
+                                         napi_value* result);
+
+// accessors read and write the field at `offset` in the pointer wrapped by napi_wrap,
+// fields must be aligned to their size, packed fields give napi_invalid_arg
+EMNAPI_EXTERN
+napi_status emnapi_define_struct_accessors(napi_env env,
+                                          napi_value object,
+                                          size_t count,
+                                          const emnapi_field_descriptor* fields);
+
+EMNAPI_EXTERN
+napi_status emnapi_get_runtime_stats(napi_env env,
+                                     emnapi_runtime_stats* result);
+
+// *result is null terminated and must be released with free()
+EMNAPI_EXTERN
+napi_status emnapi_get_value_string_utf8_alloc(napi_env env,
+                                               napi_value value,
+                                               char** result,
+                                               size_t* length);
+
 EXTERN_C_END
 
 #endif
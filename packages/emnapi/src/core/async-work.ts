@@ -206,7 +206,7 @@ var emnapiAWMT = {
       if (emnapiNodeBinding) {
         const resource = emnapiAWMT.getResource(work)
         const resource_value = emnapiCtx.refStore.get(resource)!.get()
-        const resourceObject = emnapiCtx.handleStore.get(resource_value)!.value
+        const resourceObject = emnapiCtx.handleStore.get(resource_value)
         const view = new DataView(wasmMemory.buffer)
         const asyncId = view.getFloat64(work + emnapiAWMT.offset.async_id, true)
         const triggerAsyncId = view.getFloat64(work + emnapiAWMT.offset.trigger_async_id, true)
@@ -232,14 +232,14 @@ var _napi_create_async_work = singleThreadAsyncWork
 
     let resourceObject: any
     if (resource) {
-      resourceObject = Object(emnapiCtx.handleStore.get(resource)!.value)
+      resourceObject = Object(emnapiCtx.handleStore.get(resource))
     } else {
       resourceObject = {}
     }
 
     $CHECK_ARG!(envObject, resource_name)
 
-    const resourceName = String(emnapiCtx.handleStore.get(resource_name)!.value)
+    const resourceName = String(emnapiCtx.handleStore.get(resource_name))
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
     const id = emnapiAWST.create(env, resourceObject, resourceName, execute, complete, data)
@@ -254,7 +254,7 @@ var _napi_create_async_work = singleThreadAsyncWork
 
     let resourceObject: any
     if (resource) {
-      resourceObject = Object(emnapiCtx.handleStore.get(resource)!.value)
+      resourceObject = Object(emnapiCtx.handleStore.get(resource))
     } else {
       resourceObject = {}
     }
@@ -53,6 +53,16 @@ var wasmInstance: WebAssembly.Instance
 var wasmModule: WebAssembly.Module
 var wasmMemory: WebAssembly.Memory
 
+var HEAP_DATA_VIEW: DataView
+var HEAP8: Int8Array
+var HEAPU8: Uint8Array
+var HEAP16: Int16Array
+var HEAPU16: Uint16Array
+var HEAP32: Int32Array
+var HEAPU32: Uint32Array
+var HEAPF32: Float32Array
+var HEAPF64: Float64Array
+
 var wasmTable: WebAssembly.Table
 
 var _malloc: any
@@ -65,6 +75,23 @@ function abort (msg?: string): never {
   throw Error(msg)
 }
 
+function getWasmTableEntry (funcPtr: number): Function {
+  return wasmTable.get(funcPtr)!
+}
+
+function updateMemoryViews (): void {
+  const buffer = wasmMemory.buffer
+  HEAP_DATA_VIEW = new DataView(buffer)
+  HEAP8 = new Int8Array(buffer)
+  HEAPU8 = new Uint8Array(buffer)
+  HEAP16 = new Int16Array(buffer)
+  HEAPU16 = new Uint16Array(buffer)
+  HEAP32 = new Int32Array(buffer)
+  HEAPU32 = new Uint32Array(buffer)
+  HEAPF32 = new Float32Array(buffer)
+  HEAPF64 = new Float64Array(buffer)
+}
+
 function runtimeKeepalivePush (): void {}
 
 function runtimeKeepalivePop (): void {}
@@ -101,10 +128,17 @@ var napiModule: INapiModule = {
     if (!(table instanceof WebAssembly.Table)) throw new TypeError('Invalid wasm table')
     wasmModule = module
     wasmMemory = memory
+    updateMemoryViews()
     wasmTable = table
     if (typeof exports.malloc !== 'function') throw new TypeError('malloc is not exported')
     if (typeof exports.free !== 'function') throw new TypeError('free is not exported')
-    _malloc = exports.malloc
+    const malloc = exports.malloc
+    _malloc = function (size: number): number {
+      const pointer = malloc(size)
+      // memory may grow in the middle of a function which already checked the views
+      if (HEAP_DATA_VIEW.buffer !== wasmMemory.buffer) updateMemoryViews()
+      return pointer
+    }
     _free = exports.free
 
     if (!napiModule.childThread) {
@@ -128,10 +162,10 @@ var napiModule: INapiModule = {
       try {
         envObject.callIntoModule((_envObject) => {
           const exports = napiModule.exports
-          const exportsHandle = scope.add(exports)
+          const exportsHandle = emnapiCtx.addToCurrentScope(exports)
           const napi_register_wasm_v1 = instance.exports.napi_register_wasm_v1 as Function
-          const napiValue = napi_register_wasm_v1($to64('_envObject.id'), $to64('exportsHandle.id'))
-          napiModule.exports = (!napiValue) ? exports : emnapiCtx.handleStore.get(napiValue)!.value
+          const napiValue = napi_register_wasm_v1($to64('_envObject.id'), $to64('exportsHandle'))
+          napiModule.exports = (!napiValue) ? exports : emnapiCtx.handleStore.get(napiValue)
         })
       } finally {
         emnapiCtx.closeScope(envObject, scope)
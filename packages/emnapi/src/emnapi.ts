@@ -86,7 +86,7 @@ function _emnapi_create_memory_view (
     const handle = emnapiCtx.addToCurrentScope(typedArray)
     emnapiExternalMemory.wasmMemoryViewTable.set(typedArray, viewDescriptor)
     if (finalize_cb) {
-      const status = _napi_add_finalizer(env, handle.id, external_data, finalize_cb, finalize_hint, /* NULL */ 0)
+      const status = _napi_add_finalizer(env, handle, external_data, finalize_cb, finalize_hint, /* NULL */ 0)
       if (status === napi_status.napi_pending_exception) {
         const err = envObject.tryCatch.extractException()
         envObject.clearLastError()
@@ -95,7 +95,7 @@ function _emnapi_create_memory_view (
         return envObject.setLastError(status)
       }
     }
-    value = handle.id
+    value = handle
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -179,13 +179,13 @@ function emnapi_sync_memory (env: napi_env, js_to_wasm: bool, arraybuffer_or_vie
 
     const handleId = $makeGetValue('arraybuffer_or_view', 0, '*')
 
-    const handle: Handle<ArrayBuffer | ArrayBufferView> = envObject.ctx.handleStore.get(handleId)!
-    if (!handle.isArrayBuffer() && !handle.isTypedArray() && !handle.isDataView()) {
+    const jsValue = envObject.ctx.handleStore.get(handleId)
+    if (!(jsValue instanceof ArrayBuffer) && !ArrayBuffer.isView(jsValue)) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const ret = emnapiSyncMemory(Boolean(js_to_wasm), handle.value, offset, len)
+    const ret = emnapiSyncMemory(Boolean(js_to_wasm), jsValue, offset, len)
 
-    if (handle.value !== ret) {
+    if (jsValue !== ret) {
       $from64('arraybuffer_or_view')
       v = envObject.ensureHandleId(ret)
       $makeSetValue('arraybuffer_or_view', 0, 'v', '*')
@@ -198,7 +198,7 @@ function emnapi_sync_memory (env: napi_env, js_to_wasm: bool, arraybuffer_or_vie
 function emnapiGetMemoryAddress (arrayBufferOrView: ArrayBuffer | ArrayBufferView): ArrayBufferPointer {
   const isArrayBuffer = arrayBufferOrView instanceof ArrayBuffer
   const isDataView = arrayBufferOrView instanceof DataView
-  const isTypedArray = ArrayBuffer.isView(arrayBufferOrView) && !isDataView
+  const isTypedArray = emnapiCtx.isTypedArray(arrayBufferOrView)
   if (!isArrayBuffer && !isTypedArray && !isDataView) {
     throw new TypeError('emnapiGetMemoryAddress expect ArrayBuffer or ArrayBufferView as first parameter')
   }
@@ -227,8 +227,8 @@ function emnapi_get_memory_address (env: napi_env, arraybuffer_or_view: napi_val
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
 
-    const handle: Handle<ArrayBuffer | ArrayBufferView> = envObject.ctx.handleStore.get(arraybuffer_or_view)!
-    info = emnapiGetMemoryAddress(handle.value)
+    const jsValue = envObject.ctx.handleStore.get(arraybuffer_or_view)
+    info = emnapiGetMemoryAddress(jsValue)
 
     p = info.address
     if (address) {
@@ -250,6 +250,399 @@ function emnapi_get_memory_address (env: napi_env, arraybuffer_or_view: napi_val
   })
 }
 
+function emnapi_create_values (env: napi_env, count: size_t, descriptors: Pointer<unknown>, result: Pointer<napi_value>): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $from64('count')
+  count = count >>> 0
+  if (count === 0) return envObject.clearLastError()
+  $CHECK_ARG!(envObject, descriptors)
+  $CHECK_ARG!(envObject, result)
+  $from64('descriptors')
+  $from64('result')
+
+  // sizeof(emnapi_value_descriptor), the union is at offset 8
+  const stride = 8 + 2 * $POINTER_SIZE
+  for (let i = 0; i < count; i++) {
+    const desc = descriptors + i * stride
+    let value: any
+    switch ($makeGetValue('desc', 0, 'i32') as emnapi_value_descriptor_type) {
+      case emnapi_value_descriptor_type.emnapi_value_int32:
+        value = $makeGetValue('desc', 8, 'i32')
+        break
+      case emnapi_value_descriptor_type.emnapi_value_uint32:
+        value = $makeGetValue('desc', 8, 'u32')
+        break
+      case emnapi_value_descriptor_type.emnapi_value_double:
+        value = $makeGetValue('desc', 8, 'double')
+        break
+      case emnapi_value_descriptor_type.emnapi_value_bool:
+        value = ($makeGetValue('desc', 8, 'i8') as number) !== 0
+        break
+      case emnapi_value_descriptor_type.emnapi_value_string_utf8: {
+        const strPtr = desc + 8
+        const lengthPtr = desc + 8 + $POINTER_SIZE
+        const str = $makeGetValue('strPtr', 0, '*')
+        const length = $makeGetValue('lengthPtr', 0, POINTER_WASM_TYPE)
+        $from64('str')
+        $from64('length')
+        if (length !== 0 && !str) return envObject.setLastError(napi_status.napi_invalid_arg)
+        if (length !== -1 && (length >>> 0) > 2147483647) return envObject.setLastError(napi_status.napi_invalid_arg)
+        value = emnapiString.UTF8ToString(str, length)
+        break
+      }
+      default:
+        return envObject.setLastError(napi_status.napi_invalid_arg)
+    }
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const v = envObject.ensureHandleId(value)
+    $makeSetValue('result', 'i * ' + POINTER_SIZE, 'v', '*')
+  }
+  return envObject.clearLastError()
+}
+
+function emnapi_get_named_properties (env: napi_env, object: napi_value, count: size_t, keys: Pointer<const_char_p>, values: Pointer<napi_value>): napi_status {
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  let value: number
+
+  return $PREAMBLE!(env, (envObject) => {
+    $CHECK_ARG!(envObject, object)
+    $from64('count')
+    count = count >>> 0
+    if (count !== 0) {
+      $CHECK_ARG!(envObject, keys)
+      $CHECK_ARG!(envObject, values)
+    }
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
+      throw new TypeError('Cannot convert undefined or null to object')
+    }
+    let v: any
+    try {
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
+    } catch (_) {
+      return envObject.setLastError(napi_status.napi_object_expected)
+    }
+    $from64('keys')
+    $from64('values')
+
+    for (let i = 0; i < count; i++) {
+      const key = $makeGetValue('keys', 'i * ' + POINTER_SIZE, '*')
+      $from64('key')
+      if (!key) {
+        return envObject.setLastError(napi_status.napi_invalid_arg)
+      }
+      value = envObject.ensureHandleId(v[emnapiString.propertyKeyFromUTF8(key, -1)])
+      $makeSetValue('values', 'i * ' + POINTER_SIZE, 'value', '*')
+    }
+    return envObject.getReturnStatus()
+  })
+}
+
+function emnapi_set_named_properties (env: napi_env, object: napi_value, count: size_t, keys: Pointer<const_char_p>, values: Pointer<napi_value>): napi_status {
+  return $PREAMBLE!(env, (envObject) => {
+    $CHECK_ARG!(envObject, object)
+    $from64('count')
+    count = count >>> 0
+    if (count !== 0) {
+      $CHECK_ARG!(envObject, keys)
+      $CHECK_ARG!(envObject, values)
+    }
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
+      return envObject.setLastError(napi_status.napi_object_expected)
+    }
+    $from64('keys')
+    $from64('values')
+
+    for (let i = 0; i < count; i++) {
+      const key = $makeGetValue('keys', 'i * ' + POINTER_SIZE, '*')
+      const value = $makeGetValue('values', 'i * ' + POINTER_SIZE, '*')
+      $from64('key')
+      $from64('value')
+      if (!key || !value) {
+        return envObject.setLastError(napi_status.napi_invalid_arg)
+      }
+      jsObject[emnapiString.propertyKeyFromUTF8(key, -1)] = emnapiCtx.handleStore.get(value)
+    }
+    return envObject.getReturnStatus()
+  })
+}
+
+function emnapi_enable_property_key_cache (env: napi_env, begin: void_p, size: size_t): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $from64('begin')
+  $from64('size')
+  if (size !== 0) {
+    $CHECK_ARG!(envObject, begin)
+  }
+  emnapiString.keyCacheBegin = begin >>> 0
+  emnapiString.keyCacheEnd = (begin >>> 0) + (size >>> 0)
+  emnapiString.keyCache.clear()
+  emnapiCtx.handleStore.releasePropertyKeys()
+  return envObject.clearLastError()
+}
+
+function emnapi_create_property_key_utf8 (env: napi_env, str: const_char_p, length: size_t, result: Pointer<napi_value>): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $from64('length')
+  const autoLength = length === -1
+  const sizelength = length >>> 0
+  if (length !== 0) {
+    $CHECK_ARG!(envObject, str)
+  }
+  $CHECK_ARG!(envObject, result)
+  $from64('str')
+  if (!(autoLength || (sizelength <= 2147483647))) {
+    return envObject.setLastError(napi_status.napi_invalid_arg)
+  }
+
+  const key = emnapiString.propertyKeyFromUTF8(str, length)
+  const value = emnapiCtx.handleStore.pushPropertyKey(key)
+  $from64('result')
+  $makeSetValue('result', 0, 'value', '*')
+  return envObject.clearLastError()
+}
+
+function emnapiCreateTypedFunction (name: string, ret: string, params: string, wasmFunction: Function, data: any): Function {
+  const paramCount = params.length
+  let f: Function
+// #if DYNAMIC_EXECUTION
+  if (emnapiCtx.feature.supportNewFunction) {
+    const argNames: string[] = []
+    const callArgs: string[] = []
+    for (let i = 0; i < paramCount; i++) {
+      const c = params.charAt(i)
+      if (c === 'p') {
+        callArgs.push('d')
+        continue
+      }
+      const a = 'a' + argNames.length
+      argNames.push(a)
+      callArgs.push(c === 'i' ? a + '|0' : c === 'u' ? a + '>>>0' : '+' + a)
+    }
+    let call = 'w(' + callArgs.join(',') + ')'
+    if (ret === 'u') call = '(' + call + ')>>>0'
+    try {
+      return (new Function('w', 'd',
+        'return function ' + name + '(' + argNames.join(',') + '){' +
+          '"use strict";' +
+          (ret === 'v' ? call + ';' : 'return ' + call + ';') +
+        '};'
+      ))(wasmFunction, data)
+    } catch (_) {}
+  }
+// #endif
+  f = function (): any {
+    'use strict'
+    const args = new Array(paramCount)
+    let j = 0
+    for (let i = 0; i < paramCount; i++) {
+      const c = params.charAt(i)
+      args[i] = c === 'p' ? data : c === 'i' ? arguments[j++] | 0 : c === 'u' ? arguments[j++] >>> 0 : +arguments[j++]
+    }
+    const r = wasmFunction.apply(undefined, args)
+    return ret === 'v' ? undefined : ret === 'u' ? r >>> 0 : r
+  }
+  if (name && emnapiCtx.feature.canSetFunctionName) Object.defineProperty(f, 'name', { value: name })
+  return f
+}
+
+function emnapi_create_function_typed (env: napi_env, utf8name: const_char_p, signature: const_char_p, cb: void_p, data: void_p, result: Pointer<napi_value>): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, signature)
+  $CHECK_ARG!(envObject, cb)
+  $CHECK_ARG!(envObject, result)
+  $from64('utf8name')
+  $from64('signature')
+  $from64('cb')
+  $from64('result')
+
+  const functionName = utf8name ? emnapiString.UTF8ToString(utf8name, -1) : ''
+  if (functionName !== '' && !(/^[_$a-zA-Z][_$a-zA-Z0-9]*$/.test(functionName))) {
+    return envObject.setLastError(napi_status.napi_invalid_arg)
+  }
+  const match = /^([iufdv])\(([iufdp]*)\)$/.exec(emnapiString.UTF8ToString(signature, -1))
+  if (match === null) {
+    return envObject.setLastError(napi_status.napi_invalid_arg)
+  }
+
+  // the table entry is called directly rather than through a dynCall wrapper:
+  // no parameter is i64 on wasm32 and MEMORY64 requires WASM_BIGINT,
+  // so no signature needs legalizing whatever the DYNCALLS setting is
+  const wasmFunction = getWasmTableEntry(cb)
+  const f = emnapiCreateTypedFunction(functionName, match[1], match[2], wasmFunction, $to64('data'))
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  const value = emnapiCtx.addToCurrentScope(f)
+  $makeSetValue('result', 0, 'value', '*')
+  return envObject.clearLastError()
+}
+
+function emnapiFieldSize (type: emnapi_field_type): number {
+  switch (type) {
+    case emnapi_field_type.emnapi_field_int16:
+    case emnapi_field_type.emnapi_field_uint16: return 2
+    case emnapi_field_type.emnapi_field_int32:
+    case emnapi_field_type.emnapi_field_uint32:
+    case emnapi_field_type.emnapi_field_float: return 4
+    case emnapi_field_type.emnapi_field_double: return 8
+    default: return 1
+  }
+}
+
+function emnapiFieldAddress (envObject: Env, obj: any, offset: number, size: number): number {
+  const ref = emnapiCtx.isReferenceType(obj)
+    ? emnapiCtx.refStore.get(envObject.getObjectBinding(obj).wrapped)
+    : undefined
+  if (!ref) {
+    throw new TypeError('Illegal invocation')
+  }
+  const address = ref.data() + offset
+  // heap views index by element, a misaligned address would hit its neighbour
+  if (address % size !== 0) {
+    throw new RangeError('Misaligned struct field')
+  }
+  return address
+}
+
+function emnapiCreateFieldAccessor (envObject: Env, offset: number, type: emnapi_field_type, size: number, writable: boolean): PropertyDescriptor {
+  const get = function (this: any): number | boolean {
+    const p = emnapiFieldAddress(envObject, this, offset, size)
+    switch (type) {
+      case emnapi_field_type.emnapi_field_int8: return $makeGetValue('p', 0, 'i8') as number
+      case emnapi_field_type.emnapi_field_uint8: return $makeGetValue('p', 0, 'u8') as number
+      case emnapi_field_type.emnapi_field_int16: return $makeGetValue('p', 0, 'i16') as number
+      case emnapi_field_type.emnapi_field_uint16: return $makeGetValue('p', 0, 'u16') as number
+      case emnapi_field_type.emnapi_field_int32: return $makeGetValue('p', 0, 'i32') as number
+      case emnapi_field_type.emnapi_field_uint32: return $makeGetValue('p', 0, 'u32') as number
+      case emnapi_field_type.emnapi_field_float: return $makeGetValue('p', 0, 'float') as number
+      case emnapi_field_type.emnapi_field_double: return $makeGetValue('p', 0, 'double') as number
+      default: return ($makeGetValue('p', 0, 'i8') as number) !== 0
+    }
+  }
+  const set = function (this: any, value: any): void {
+    const p = emnapiFieldAddress(envObject, this, offset, size)
+    switch (type) {
+      case emnapi_field_type.emnapi_field_int8:
+      case emnapi_field_type.emnapi_field_uint8:
+        $makeSetValue('p', 0, 'value', 'i8')
+        break
+      case emnapi_field_type.emnapi_field_int16:
+      case emnapi_field_type.emnapi_field_uint16:
+        $makeSetValue('p', 0, 'value', 'i16')
+        break
+      case emnapi_field_type.emnapi_field_int32:
+      case emnapi_field_type.emnapi_field_uint32:
+        $makeSetValue('p', 0, 'value', 'i32')
+        break
+      case emnapi_field_type.emnapi_field_float:
+        $makeSetValue('p', 0, 'value', 'float')
+        break
+      case emnapi_field_type.emnapi_field_double:
+        $makeSetValue('p', 0, 'value', 'double')
+        break
+      default:
+        $makeSetValue('p', 0, 'value ? 1 : 0', 'i8')
+        break
+    }
+  }
+  return { get, set: writable ? set : undefined }
+}
+
+function emnapi_define_struct_accessors (env: napi_env, object: napi_value, count: size_t, fields: Pointer<unknown>): napi_status {
+  return $PREAMBLE!(env, (envObject) => {
+    $CHECK_ARG!(envObject, object)
+    $from64('count')
+    count = count >>> 0
+    if (count !== 0) {
+      $CHECK_ARG!(envObject, fields)
+    }
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
+      return envObject.setLastError(napi_status.napi_object_expected)
+    }
+    $from64('fields')
+
+    // sizeof(emnapi_field_descriptor)
+    const stride = 2 * $POINTER_SIZE + 8
+    for (let i = 0; i < count; i++) {
+      const field = fields + i * stride
+      const utf8name = $makeGetValue('field', 0, '*')
+      const offset = $makeGetValue('field', POINTER_SIZE, SIZE_TYPE)
+      const type = $makeGetValue('field', POINTER_SIZE * 2, 'i32') as emnapi_field_type
+      const attributesPtr = field + 2 * $POINTER_SIZE + 4
+      const attributes = $makeGetValue('attributesPtr', 0, 'i32') as number
+      $from64('utf8name')
+      $from64('offset')
+      if (!utf8name || type < emnapi_field_type.emnapi_field_int8 || type > emnapi_field_type.emnapi_field_bool) {
+        return envObject.setLastError(napi_status.napi_invalid_arg)
+      }
+      const size = emnapiFieldSize(type)
+      if (offset % size !== 0) {
+        return envObject.setLastError(napi_status.napi_invalid_arg)
+      }
+      const desc = emnapiCreateFieldAccessor(envObject, offset, type, size, (attributes & napi_property_attributes.napi_writable) !== 0)
+      desc.configurable = (attributes & napi_property_attributes.napi_configurable) !== 0
+      desc.enumerable = (attributes & napi_property_attributes.napi_enumerable) !== 0
+      Object.defineProperty(jsObject, emnapiString.UTF8ToString(utf8name, -1), desc)
+    }
+    return envObject.getReturnStatus()
+  })
+}
+
+function emnapi_get_runtime_stats (env: napi_env, result: Pointer<emnapi_runtime_stats>): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, result)
+  $from64('result')
+
+  const stats = emnapiCtx.getStats()
+  $makeSetValue('result', 0, 'stats.handleCount', 'u32')
+  $makeSetValue('result', 4, 'stats.peakHandleCount', 'u32')
+  $makeSetValue('result', 8, 'stats.persistentHandleCount', 'u32')
+  $makeSetValue('result', 12, 'stats.scopeDepth', 'u32')
+  $makeSetValue('result', 16, 'stats.peakScopeDepth', 'u32')
+  $makeSetValue('result', 20, 'stats.referenceCount', 'u32')
+  $makeSetValue('result', 24, 'stats.deferredCount', 'u32')
+  $makeSetValue('result', 28, 'stats.finalizerCount', 'u32')
+  $makeSetValue('result', 32, 'stats.pendingFinalizerCount', 'u32')
+  $makeSetValue('result', 36, 'stats.handleCapacity', 'u32')
+  return envObject.clearLastError()
+}
+
+function emnapi_get_value_string_utf8_alloc (env: napi_env, value: napi_value, result: Pointer<char_p>, length: Pointer<size_t>): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, value)
+  $CHECK_ARG!(envObject, result)
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'string') {
+    return envObject.setLastError(napi_status.napi_string_expected)
+  }
+  const size = emnapiString.queryLengthUTF8(value, jsValue) + 1
+  let buf = _malloc($to64('size'))
+  $from64('buf')
+  if (!buf) {
+    return envObject.setLastError(napi_status.napi_generic_failure)
+  }
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  const copied = emnapiString.copyUTF8(value, jsValue, buf, size)
+  $from64('result')
+  $from64('length')
+  $makeSetValue('result', 0, 'buf', '*')
+  if (length) {
+    $makeSetValue('length', 0, 'copied', SIZE_TYPE)
+  }
+  return envObject.clearLastError()
+}
+
+emnapiImplementHelper('$emnapiCreateTypedFunction', undefined, emnapiCreateTypedFunction)
+emnapiImplementHelper('$emnapiFieldSize', undefined, emnapiFieldSize)
+emnapiImplementHelper('$emnapiFieldAddress', undefined, emnapiFieldAddress)
+emnapiImplementHelper('$emnapiCreateFieldAccessor', undefined, emnapiCreateFieldAccessor, ['$emnapiFieldAddress'])
 emnapiImplementHelper('$emnapiSyncMemory', undefined, emnapiSyncMemory, ['$emnapiExternalMemory'], 'syncMemory')
 emnapiImplementHelper('$emnapiGetMemoryAddress', undefined, emnapiGetMemoryAddress, ['$emnapiExternalMemory'], 'getMemoryAddress')
 
@@ -260,3 +653,12 @@ emnapiImplement2('emnapi_is_node_binding_available', 'i', emnapi_is_node_binding
 emnapiImplement2('emnapi_create_memory_view', 'ipippppp', _emnapi_create_memory_view, ['napi_add_finalizer', '$emnapiExternalMemory'])
 emnapiImplement2('emnapi_sync_memory', 'ipippp', emnapi_sync_memory, ['$emnapiSyncMemory'])
 emnapiImplement2('emnapi_get_memory_address', 'ipppp', emnapi_get_memory_address, ['$emnapiGetMemoryAddress'])
+emnapiImplement2('emnapi_create_values', 'ippp', emnapi_create_values, ['$emnapiString'])
+emnapiImplement2('emnapi_get_named_properties', 'ippppp', emnapi_get_named_properties, ['$emnapiString'])
+emnapiImplement2('emnapi_set_named_properties', 'ippppp', emnapi_set_named_properties, ['$emnapiString'])
+emnapiImplement2('emnapi_enable_property_key_cache', 'ippp', emnapi_enable_property_key_cache, ['$emnapiString'])
+emnapiImplement2('emnapi_create_property_key_utf8', 'ipppp', emnapi_create_property_key_utf8, ['$emnapiString'])
+emnapiImplement2('emnapi_create_function_typed', 'ipppppp', emnapi_create_function_typed, ['$emnapiString', '$emnapiCreateTypedFunction', '$getWasmTableEntry'])
+emnapiImplement2('emnapi_define_struct_accessors', 'ipppp', emnapi_define_struct_accessors, ['$emnapiString', '$emnapiFieldSize', '$emnapiCreateFieldAccessor'])
+emnapiImplement2('emnapi_get_runtime_stats', 'ipp', emnapi_get_runtime_stats)
+emnapiImplement2('emnapi_get_value_string_utf8_alloc', 'ipppp', emnapi_get_value_string_utf8_alloc, ['malloc', '$emnapiString'])
@@ -6,14 +6,14 @@ function _napi_create_async_work (env: napi_env, resource: napi_value, resource_
 
   let resourceObject: any
   if (resource) {
-    resourceObject = Object(emnapiCtx.handleStore.get(resource)!.value)
+    resourceObject = Object(emnapiCtx.handleStore.get(resource))
   } else {
     resourceObject = {}
   }
 
   $CHECK_ARG!(envObject, resource_name)
 
-  const resourceName = String(emnapiCtx.handleStore.get(resource_name)!.value)
+  const resourceName = String(emnapiCtx.handleStore.get(resource_name))
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const id = emnapiAWST.create(env, resourceObject, resourceName, execute, complete, data)
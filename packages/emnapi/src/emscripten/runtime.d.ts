@@ -34,6 +34,7 @@ declare function _malloc (size: number | bigint): void_p
 // declare function addOnInit (callback: number | ((Module: any) => void) | LifecycleCallback<any>): void
 // declare function addOnExit (callback: number | ((Module: any) => void) | LifecycleCallback<any>): void
 declare function abort (msg?: string): never
+declare function getWasmTableEntry (funcPtr: number): Function
 
 declare function runtimeKeepalivePush (): void
 declare function runtimeKeepalivePop (): void
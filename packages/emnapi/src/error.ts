@@ -1,27 +1,58 @@
-function __emnapi_get_last_error_info (env: napi_env, error_code: Pointer<napi_status>, engine_error_code: Pointer<uint32_t>, engine_reserved: void_pp): void {
-  $from64('error_code')
-  $from64('engine_error_code')
-  $from64('engine_reserved')
-  const envObject = emnapiCtx.envStore.get(env)!
+function emnapiCreateMemoryLastError (address: number, lastError: ILastError): ILastError & { address: number } {
+  // laid out as napi_extended_error_info, error_message is filled by C
+  const engineReservedPtr = address + $POINTER_SIZE
+  const engineErrorCodePtr = address + 2 * $POINTER_SIZE
+  const errorCodePtr = address + 2 * $POINTER_SIZE + 4
+  const memoryLastError = {
+    address,
+    get errorCode (): napi_status {
+      return $makeGetValue('errorCodePtr', 0, 'i32') as napi_status
+    },
+    set errorCode (value: napi_status) {
+      $makeSetValue('errorCodePtr', 0, 'value', 'i32')
+    },
+    get engineErrorCode (): uint32_t {
+      return $makeGetValue('engineErrorCodePtr', 0, 'u32') as uint32_t
+    },
+    set engineErrorCode (value: uint32_t) {
+      $makeSetValue('engineErrorCodePtr', 0, 'value', 'u32')
+    },
+    get engineReserved (): Ptr {
+      const value = $makeGetValue('engineReservedPtr', 0, '*')
+      $from64('value')
+      return value
+    },
+    set engineReserved (value: Ptr) {
+      $makeSetValue('engineReservedPtr', 0, 'value', '*')
+    }
+  }
+  $makeSetValue('address', 0, '0', '*')
+  memoryLastError.errorCode = lastError.errorCode
+  memoryLastError.engineErrorCode = lastError.engineErrorCode >>> 0
+  memoryLastError.engineReserved = lastError.engineReserved
+  return memoryLastError
+}
 
-  const lastError = envObject.lastError
-  // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const errorCode = lastError.errorCode
-  // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const engineErrorCode = lastError.engineErrorCode >>> 0
+function __emnapi_get_last_error_info_address (env: napi_env): Pointer<napi_extended_error_info> {
+  const envObject = emnapiCtx.envStore.get(env)!
+  let lastError = envObject.lastError as ILastError & { address?: number }
+  if (lastError.address === undefined) {
+    // never freed, an env lives as long as its module
+    const size = 2 * $POINTER_SIZE + 8
+    let pointer = _malloc($to64('size'))
+    $from64('pointer')
+    lastError = emnapiCreateMemoryLastError(pointer, lastError)
+    envObject.lastError = lastError
+  }
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const engineReserved = lastError.engineReserved
-  $from64('engineReserved')
-
-  $makeSetValue('error_code', 0, 'errorCode', 'i32')
-  $makeSetValue('engine_error_code', 0, 'engineErrorCode', 'u32')
-  $makeSetValue('engine_reserved', 0, 'engineReserved', '*')
+  const address = lastError.address
+  return $to64('address') as number
 }
 
 function napi_throw (env: napi_env, error: napi_value): napi_status {
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, error)
-    envObject.tryCatch.setError(emnapiCtx.handleStore.get(error)!.value)
+    envObject.tryCatch.setError(emnapiCtx.handleStore.get(error))
     return envObject.clearLastError()
   })
 }
@@ -98,14 +129,14 @@ function napi_create_error (env: napi_env, code: napi_value, msg: napi_value, re
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.get(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
 
   const error = new Error(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.get(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -115,7 +146,7 @@ function napi_create_error (env: napi_env, code: napi_value, msg: napi_value, re
   $from64('result')
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope(error).id
+  const value = emnapiCtx.addToCurrentScope(error)
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -125,13 +156,13 @@ function napi_create_type_error (env: napi_env, code: napi_value, msg: napi_valu
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.get(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   const error = new TypeError(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.get(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -141,7 +172,7 @@ function napi_create_type_error (env: napi_env, code: napi_value, msg: napi_valu
   $from64('result')
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope(error).id
+  const value = emnapiCtx.addToCurrentScope(error)
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -151,13 +182,13 @@ function napi_create_range_error (env: napi_env, code: napi_value, msg: napi_val
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.get(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   const error = new RangeError(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.get(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -166,7 +197,7 @@ function napi_create_range_error (env: napi_env, code: napi_value, msg: napi_val
   $from64('result')
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope(error).id
+  const value = emnapiCtx.addToCurrentScope(error)
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -176,13 +207,13 @@ function node_api_create_syntax_error (env: napi_env, code: napi_value, msg: nap
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.get(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   const error = new SyntaxError(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.get(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -191,7 +222,7 @@ function node_api_create_syntax_error (env: napi_env, code: napi_value, msg: nap
   $from64('result')
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope(error).id
+  const value = emnapiCtx.addToCurrentScope(error)
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -233,9 +264,9 @@ function napi_fatal_error (location: const_char_p, location_len: size_t, message
 function napi_fatal_exception (env: napi_env, err: napi_value): napi_status {
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, err)
-    const error = envObject.ctx.handleStore.get(err)!
+    const error = envObject.ctx.handleStore.get(err)
     try {
-      (envObject as NodeEnv).triggerFatalException(error.value)
+      (envObject as NodeEnv).triggerFatalException(error)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_generic_failure)
     }
@@ -243,7 +274,8 @@ function napi_fatal_exception (env: napi_env, err: napi_value): napi_status {
   })
 }
 
-emnapiImplementInternal('_emnapi_get_last_error_info', 'vpppp', __emnapi_get_last_error_info)
+emnapiImplementHelper('$emnapiCreateMemoryLastError', undefined, emnapiCreateMemoryLastError)
+emnapiImplementInternal('_emnapi_get_last_error_info_address', 'pp', __emnapi_get_last_error_info_address, ['malloc', '$emnapiCreateMemoryLastError'])
 
 emnapiImplement('napi_get_and_clear_last_exception', 'ipp', napi_get_and_clear_last_exception)
 emnapiImplement('napi_throw', 'ipp', napi_throw)
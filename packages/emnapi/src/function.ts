@@ -11,10 +11,9 @@ function napi_create_function (env: napi_env, utf8name: Pointer<const_char>, len
     const fresult = emnapiCreateFunction(envObject, utf8name, length, cb, data)
     if (fresult.status !== napi_status.napi_ok) return envObject.setLastError(fresult.status)
     const f = fresult.f
-    const valueHandle = emnapiCtx.addToCurrentScope(f)
     $from64('result')
 
-    value = valueHandle.id
+    value = emnapiCtx.addToCurrentScope(f)
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -34,13 +33,14 @@ function napi_get_cb_info (env: napi_env, _cbinfo: napi_callback_info, argc: Poi
     const argcValue = $makeGetValue('argc', 0, SIZE_TYPE)
     $from64('argcValue')
 
-    const len = cbinfoValue.args.length
+    const len = cbinfoValue.argc
     const arrlen = argcValue < len ? argcValue : len
+    const argsStart = cbinfoValue.argsStart
     let i = 0
 
     for (; i < arrlen; i++) {
       // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      const argVal = envObject.ensureHandleId(cbinfoValue.args[i])
+      const argVal = argsStart + i
       $makeSetValue('argv', 'i * ' + POINTER_SIZE, 'argVal', '*')
     }
     if (i < argcValue) {
@@ -50,14 +50,12 @@ function napi_get_cb_info (env: napi_env, _cbinfo: napi_callback_info, argc: Poi
     }
   }
   if (argc) {
-    $makeSetValue('argc', 0, 'cbinfoValue.args.length', SIZE_TYPE)
+    $makeSetValue('argc', 0, 'cbinfoValue.argc', SIZE_TYPE)
   }
   if (this_arg) {
     $from64('this_arg')
 
-    // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const v = envObject.ensureHandleId(cbinfoValue.thiz)
-    $makeSetValue('this_arg', 0, 'v', '*')
+    $makeSetValue('this_arg', 0, 'cbinfoValue.thisHandle', '*')
   }
   if (data) {
     $from64('data')
@@ -89,14 +87,14 @@ function napi_call_function (
     if (argc > 0) {
       if (!argv) return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const v8recv = emnapiCtx.handleStore.get(recv)!.value
+    const v8recv = emnapiCtx.handleStore.get(recv)
     if (!func) return envObject.setLastError(napi_status.napi_invalid_arg)
-    const v8func = emnapiCtx.handleStore.get(func)!.value as Function
+    const v8func = emnapiCtx.handleStore.get(func) as Function
     if (typeof v8func !== 'function') return envObject.setLastError(napi_status.napi_invalid_arg)
     const args = []
     for (; i < argc; i++) {
       const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-      args.push(emnapiCtx.handleStore.get(argVal)!.value)
+      args.push(emnapiCtx.handleStore.get(argVal))
     }
     const ret = v8func.apply(v8recv, args)
     if (result) {
@@ -130,14 +128,14 @@ function napi_new_instance (
     }
     if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
 
-    const Ctor: new (...args: any[]) => any = emnapiCtx.handleStore.get(constructor)!.value
+    const Ctor: new (...args: any[]) => any = emnapiCtx.handleStore.get(constructor)
     if (typeof Ctor !== 'function') return envObject.setLastError(napi_status.napi_invalid_arg)
     let ret: any
     if (emnapiCtx.feature.supportReflect) {
       const argList = Array(argc)
       for (i = 0; i < argc; i++) {
         const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-        argList[i] = emnapiCtx.handleStore.get(argVal)!.value
+        argList[i] = emnapiCtx.handleStore.get(argVal)
       }
       ret = Reflect.construct(Ctor, argList, Ctor)
     } else {
@@ -145,7 +143,7 @@ function napi_new_instance (
       args[0] = undefined
       for (i = 0; i < argc; i++) {
         const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-        args[i + 1] = emnapiCtx.handleStore.get(argVal)!.value
+        args[i + 1] = emnapiCtx.handleStore.get(argVal)
       }
       const BoundCtor = Ctor.bind.apply(Ctor, args) as new () => any
       ret = new BoundCtor()
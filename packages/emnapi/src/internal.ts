@@ -9,18 +9,27 @@ function emnapiCreateFunction<F extends (...args: any[]) => any> (envObject: Env
 
   let f: F
 
+  // arguments are only read by index here so that no arguments object or closure is allocated per call
   const makeFunction = () => function (this: any): any {
     'use strict'
-    emnapiCtx.cbinfoStack.push(this, data, arguments, f)
-    const scope = emnapiCtx.openScope(envObject)
+    const scopeStore = emnapiCtx.scopeStore
+    const cbinfoStack = emnapiCtx.cbinfoStack
+    scopeStore.openScope(envObject)
+    const thisHandle = scopeStore.add(this)
+    const argc = arguments.length
+    for (let i = 0; i < argc; ++i) {
+      scopeStore.add(arguments[i])
+    }
+    cbinfoStack.push(this, data, thisHandle, argc, f)
+    const openHandleScopesBefore = envObject.openHandleScopes
+    envObject.clearLastError()
     try {
-      return envObject.callIntoModule((envObject) => {
-        const napiValue = $makeDynCall('ppp', 'cb')(envObject.id, 0)
-        return (!napiValue) ? undefined : emnapiCtx.handleStore.get(napiValue)!.value
-      })
+      const napiValue = $makeDynCall('ppp', 'cb')(envObject.id, 0)
+      envObject.leaveModule(openHandleScopesBefore)
+      return (!napiValue) ? undefined : emnapiCtx.handleStore.get(napiValue)
     } finally {
-      emnapiCtx.cbinfoStack.pop()
-      emnapiCtx.closeScope(envObject, scope)
+      cbinfoStack.pop()
+      scopeStore.closeScope(envObject)
     }
   }
 
@@ -89,25 +98,62 @@ function emnapiDefineProperty (envObject: Env, obj: object, propertyName: string
       configurable: (attributes & napi_property_attributes.napi_configurable) !== 0,
       enumerable: (attributes & napi_property_attributes.napi_enumerable) !== 0,
       writable: (attributes & napi_property_attributes.napi_writable) !== 0,
-      value: emnapiCtx.handleStore.get(value)!.value
+      value: emnapiCtx.handleStore.get(value)
     }
     Object.defineProperty(obj, propertyName, desc)
   }
 }
 
-function emnapiGetHandle (js_object: napi_value): { status: napi_status; handle?: Handle<any> } {
-  let handle = emnapiCtx.handleStore.get(js_object)!
-  if (!(handle.isObject() || handle.isFunction())) {
+// the trampoline is only created when the method is first read, the accessor then replaces itself with a data property
+function emnapiDefineLazyMethod (envObject: Env, obj: object, propertyName: string | symbol, method: napi_callback, attributes: number, data: void_p): void {
+  const enumerable = (attributes & napi_property_attributes.napi_enumerable) !== 0
+  const writable = (attributes & napi_property_attributes.napi_writable) !== 0
+  let localMethod: Function | undefined
+  const materialize = function (): Function {
+    if (localMethod === undefined) {
+      localMethod = emnapiCreateFunction(envObject, 0, 0, method, data).f
+    }
+    // a frozen or sealed object keeps the accessor, which returns the same function on every read
+    if (Object.isExtensible(obj)) {
+      const desc = Object.getOwnPropertyDescriptor(obj, propertyName)
+      if (desc !== undefined && desc.configurable) {
+        Object.defineProperty(obj, propertyName, { configurable: true, enumerable, writable, value: localMethod })
+      }
+    }
+    return localMethod
+  }
+  Object.defineProperty(obj, propertyName, {
+    configurable: true,
+    enumerable,
+    get: materialize,
+    set: writable
+      ? function (this: any, value: any): void {
+        // same as assigning to a writable data property found on the prototype chain
+        Object.defineProperty(this, propertyName, {
+          configurable: true,
+          enumerable: this === obj ? enumerable : true,
+          writable: true,
+          value
+        })
+      }
+      : undefined
+  })
+}
+
+function emnapiGetHandle (js_object: napi_value): { status: napi_status; handle?: napi_value } {
+  const value = emnapiCtx.handleStore.get(js_object)
+  if (!emnapiCtx.isReferenceType(value)) {
     return { status: napi_status.napi_invalid_arg }
   }
 
-  if (typeof emnapiExternalMemory !== 'undefined' && ArrayBuffer.isView(handle.value)) {
-    if (emnapiExternalMemory.wasmMemoryViewTable.has(handle.value)) {
-      handle = emnapiCtx.addToCurrentScope(emnapiExternalMemory.wasmMemoryViewTable.get(handle.value)!)
+  if (typeof emnapiExternalMemory !== 'undefined' && ArrayBuffer.isView(value)) {
+    if (emnapiExternalMemory.wasmMemoryViewTable.has(value)) {
+      const handle = emnapiCtx.addToCurrentScope(emnapiExternalMemory.wasmMemoryViewTable.get(value)!)
+      return { status: napi_status.napi_ok, handle }
     }
   }
 
-  return { status: napi_status.napi_ok, handle }
+  return { status: napi_status.napi_ok, handle: js_object }
 }
 
 function emnapiWrap (env: napi_env, js_object: napi_value, native_object: void_p, finalize_cb: napi_finalize, finalize_hint: void_p, result: Pointer<napi_ref>): napi_status {
@@ -129,23 +175,24 @@ function emnapiWrap (env: napi_env, js_object: napi_value, native_object: void_p
       return envObject.setLastError(handleResult.status)
     }
     const handle = handleResult.handle!
+    const value = emnapiCtx.handleStore.get(handle)
 
-    if (envObject.getObjectBinding(handle.value).wrapped !== 0) {
+    if (envObject.getObjectBinding(value).wrapped !== 0) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
 
     let reference: Reference
     if (result) {
       if (!finalize_cb) return envObject.setLastError(napi_status.napi_invalid_arg)
-      reference = emnapiCtx.createReference(envObject, handle.id, 0, Ownership.kUserland as any, finalize_cb, native_object, finalize_hint)
+      reference = emnapiCtx.createReference(envObject, handle, 0, Ownership.kUserland as any, finalize_cb, native_object, finalize_hint)
       $from64('result')
       referenceId = reference.id
       $makeSetValue('result', 0, 'referenceId', '*')
     } else {
-      reference = emnapiCtx.createReference(envObject, handle.id, 0, Ownership.kRuntime as any, finalize_cb, native_object, !finalize_cb ? finalize_cb : finalize_hint)
+      reference = emnapiCtx.createReference(envObject, handle, 0, Ownership.kRuntime as any, finalize_cb, native_object, !finalize_cb ? finalize_cb : finalize_hint)
     }
 
-    envObject.getObjectBinding(handle.value).wrapped = reference.id
+    envObject.getObjectBinding(value).wrapped = reference.id
     return envObject.getReturnStatus()
   })
 }
@@ -158,11 +205,11 @@ function emnapiUnwrap (env: napi_env, js_object: napi_value, result: void_pp, ac
     if (action === UnwrapAction.KeepWrap) {
       if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const value = emnapiCtx.handleStore.get(js_object)!
-    if (!(value.isObject() || value.isFunction())) {
+    const value = emnapiCtx.handleStore.get(js_object)
+    if (!emnapiCtx.isReferenceType(value)) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const binding = envObject.getObjectBinding(value.value)
+    const binding = envObject.getObjectBinding(value)
     const referenceId = binding.wrapped
     const ref = emnapiCtx.refStore.get(referenceId)
     if (!ref) return envObject.setLastError(napi_status.napi_invalid_arg)
@@ -188,6 +235,7 @@ function emnapiUnwrap (env: napi_env, js_object: napi_value, result: void_pp, ac
 
 emnapiImplementHelper('$emnapiCreateFunction', undefined, emnapiCreateFunction, ['$emnapiString'])
 emnapiImplementHelper('$emnapiDefineProperty', undefined, emnapiDefineProperty, ['$emnapiCreateFunction'])
+emnapiImplementHelper('$emnapiDefineLazyMethod', undefined, emnapiDefineLazyMethod, ['$emnapiCreateFunction'])
 emnapiImplementHelper('$emnapiGetHandle', undefined, emnapiGetHandle)
 emnapiImplementHelper('$emnapiWrap', undefined, emnapiWrap, ['$emnapiGetHandle'])
 emnapiImplementHelper('$emnapiUnwrap', undefined, emnapiUnwrap)
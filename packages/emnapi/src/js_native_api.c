@@ -33,14 +33,29 @@ static const char* emnapi_error_messages[] = {
   "Cannot run JavaScript",
 };
 
-EMNAPI_INTERNAL_EXTERN void _emnapi_get_last_error_info(napi_env env,
-                                        napi_status* error_code,
-                                        uint32_t* engine_error_code,
-                                        void** engine_reserved);
+// written by the JS side on every call, laid out as napi_extended_error_info
+EMNAPI_INTERNAL_EXTERN
+napi_extended_error_info* _emnapi_get_last_error_info_address(napi_env env);
+
+#if EMNAPI_HAVE_THREADS
+#define EMNAPI_THREAD_LOCAL _Thread_local
+#else
+#define EMNAPI_THREAD_LOCAL
+#endif
+
+static napi_extended_error_info* emnapi_last_error_info(napi_env env) {
+  // env ids are only unique per thread
+  static EMNAPI_THREAD_LOCAL napi_env last_env = NULL;
+  static EMNAPI_THREAD_LOCAL napi_extended_error_info* last_error = NULL;
+  if (env != last_env) {
+    last_error = _emnapi_get_last_error_info_address(env);
+    last_env = env;
+  }
+  return last_error;
+}
 
 napi_status napi_get_last_error_info(
     napi_env env, const napi_extended_error_info** result) {
-  static napi_extended_error_info last_error;
   CHECK_ENV(env);
   CHECK_ARG(env, result);
 
@@ -49,24 +64,230 @@ napi_status napi_get_last_error_info(
   static_assert((sizeof(emnapi_error_messages) / sizeof(const char*)) == napi_cannot_run_js + 1,
                 "Count of error messages must match count of error values");
 
-  _emnapi_get_last_error_info(env,
-                              &last_error.error_code,
-                              &last_error.engine_error_code,
-                              &last_error.engine_reserved);
+  napi_extended_error_info* last_error = emnapi_last_error_info(env);
 
-  CHECK_LE(last_error.error_code, last_status);
+  CHECK_LE(last_error->error_code, last_status);
 
-  last_error.error_message = emnapi_error_messages[last_error.error_code];
+  last_error->error_message = emnapi_error_messages[last_error->error_code];
 
-  if (last_error.error_code == napi_ok) {
-    napi_clear_last_error(env);
-    last_error.engine_error_code = 0;
-    last_error.engine_reserved = NULL;
+  if (last_error->error_code == napi_ok) {
+    last_error->engine_error_code = 0;
+    last_error->engine_reserved = NULL;
   }
-  *result = &last_error;
+  *result = last_error;
+  return napi_ok;
+}
+
+#if defined(EMNAPI_TAGGED_VALUES) && !defined(__wasm64__)
+#define EMNAPI_USE_TAGGED_VALUES 1
+#else
+#define EMNAPI_USE_TAGGED_VALUES 0
+#endif
+
+#ifdef EMNAPI_TYPE_TABLE
+#define EMNAPI_USE_TYPE_TABLE 1
+#else
+#define EMNAPI_USE_TYPE_TABLE 0
+#endif
+
+// constant handles, keep in sync with GlobalHandle
+#define EMNAPI_HANDLE_UNDEFINED ((napi_value) (uintptr_t) 1)
+#define EMNAPI_HANDLE_NULL ((napi_value) (uintptr_t) 2)
+#define EMNAPI_HANDLE_FALSE ((napi_value) (uintptr_t) 3)
+#define EMNAPI_HANDLE_TRUE ((napi_value) (uintptr_t) 4)
+#define EMNAPI_HANDLE_GLOBAL ((napi_value) (uintptr_t) 5)
+
+#if EMNAPI_USE_TAGGED_VALUES || EMNAPI_USE_TYPE_TABLE
+
+static napi_status emnapi_clear_last_error(napi_env env) {
+  napi_extended_error_info* last_error = emnapi_last_error_info(env);
+  last_error->error_code = napi_ok;
+  last_error->engine_error_code = 0;
+  last_error->engine_reserved = NULL;
   return napi_ok;
 }
 
+#endif
+
+#if EMNAPI_USE_TAGGED_VALUES
+
+// int31 immediates carry bit 31, the JS side decodes them in HandleStore.get
+#define EMNAPI_TAG_BIT ((uintptr_t) 0x80000000u)
+#define EMNAPI_IS_TAGGED(value) ((((uintptr_t) (value)) & EMNAPI_TAG_BIT) != 0)
+#define EMNAPI_TAGGED_MIN (-0x40000000)
+#define EMNAPI_TAGGED_MAX 0x3FFFFFFF
+
+// same as ToInt32 in JavaScript
+static int32_t emnapi_double_to_int32(double value) {
+  if (value > -2147483649.0 && value < 2147483648.0) {
+    return (int32_t) value;
+  }
+  if (value > -9223372036854775808.0 && value < 9223372036854775808.0) {
+    return (int32_t) (uint32_t) (uint64_t) (int64_t) value;
+  }
+  // NaN, Infinity or a large integer, only the low 32 bits matter
+  union { double d; uint64_t u; } bits = { value };
+  int shift = (int) ((bits.u >> 52) & 0x7FF) - 1075;
+  if (shift >= 32) return 0;
+  uint32_t low = (uint32_t) (((bits.u & 0xFFFFFFFFFFFFFull) | 0x10000000000000ull) << shift);
+  return (int32_t) ((bits.u >> 63) ? 0u - low : low);
+}
+
+napi_status napi_create_int32(napi_env env, int32_t value, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+
+  if (value >= EMNAPI_TAGGED_MIN && value <= EMNAPI_TAGGED_MAX) {
+    *result = (napi_value) ((((uintptr_t) (uint32_t) value) & ~EMNAPI_TAG_BIT) | EMNAPI_TAG_BIT);
+    return emnapi_clear_last_error(env);
+  }
+
+  return napi_create_double(env, (double) value, result);
+}
+
+napi_status napi_get_value_int32(napi_env env, napi_value value, int32_t* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  if (EMNAPI_IS_TAGGED(value)) {
+    *result = ((int32_t) (((uint32_t) (uintptr_t) value) << 1)) >> 1;
+    return emnapi_clear_last_error(env);
+  }
+
+  double number;
+  napi_status status = napi_get_value_double(env, value, &number);
+  if (status != napi_ok) return status;
+  *result = emnapi_double_to_int32(number);
+  return napi_ok;
+}
+
+napi_status napi_get_boolean(napi_env env, bool value, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+
+  *result = value ? EMNAPI_HANDLE_TRUE : EMNAPI_HANDLE_FALSE;
+  return emnapi_clear_last_error(env);
+}
+
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_get_value_bool(napi_env env,
+                                                          napi_value value,
+                                                          bool* result);
+
+napi_status napi_get_value_bool(napi_env env, napi_value value, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  if (value == EMNAPI_HANDLE_TRUE || value == EMNAPI_HANDLE_FALSE) {
+    *result = value == EMNAPI_HANDLE_TRUE;
+    return emnapi_clear_last_error(env);
+  }
+
+  // booleans held in scope slots are rare
+  return _emnapi_get_value_bool(env, value, result);
+}
+
+#endif
+
+#if EMNAPI_USE_TYPE_TABLE
+
+// filled by the JS side whenever a scope handle is created
+typedef struct {
+  uint8_t* types;
+  uint32_t length;
+} emnapi_type_table;
+
+// (napi_valuetype + 1) | flags, 0 means unknown,
+// objects only get EMNAPI_TYPE_OBJECT | flags, the type is found on demand
+#define EMNAPI_TYPE_MASK 0x0F
+#define EMNAPI_TYPE_ARRAY 0x10
+#define EMNAPI_TYPE_TYPEDARRAY 0x20
+#define EMNAPI_TYPE_OBJECT 0x40
+
+// keep in sync with HandleStore.PERSISTENT_BASE, only scope handles have types
+#define EMNAPI_HANDLE_PERSISTENT_BASE ((uintptr_t) 0x40000000u)
+
+EMNAPI_INTERNAL_EXTERN emnapi_type_table* _emnapi_get_type_table(napi_env env);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_typeof(napi_env env,
+                                                  napi_value value,
+                                                  napi_valuetype* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_is_array(napi_env env,
+                                                    napi_value value,
+                                                    bool* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_is_typedarray(napi_env env,
+                                                         napi_value value,
+                                                         bool* result);
+
+// one table per module, so only threads need separate caches
+static EMNAPI_THREAD_LOCAL emnapi_type_table* emnapi_types = NULL;
+
+static uint8_t* emnapi_type_slot(napi_env env, napi_value value) {
+  uintptr_t id = (uintptr_t) value;
+  if (id >= EMNAPI_HANDLE_PERSISTENT_BASE) return NULL;
+  if (emnapi_types == NULL || id >= emnapi_types->length) {
+    // the JS side only grows the table here, never while recording a handle
+    emnapi_types = _emnapi_get_type_table(env);
+    if (id >= emnapi_types->length) return NULL;
+  }
+  return emnapi_types->types + id;
+}
+
+static uint8_t emnapi_type_tag(napi_env env, napi_value value) {
+  if (value == EMNAPI_HANDLE_UNDEFINED) return napi_undefined + 1;
+  if (value == EMNAPI_HANDLE_NULL) return napi_null + 1;
+  if (value == EMNAPI_HANDLE_FALSE || value == EMNAPI_HANDLE_TRUE) return napi_boolean + 1;
+  if (value == EMNAPI_HANDLE_GLOBAL) return napi_object + 1;
+#if EMNAPI_USE_TAGGED_VALUES
+  if (EMNAPI_IS_TAGGED(value)) return napi_number + 1;
+#endif
+  uint8_t* slot = emnapi_type_slot(env, value);
+  return slot != NULL ? *slot : 0;
+}
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  uint8_t tag = emnapi_type_tag(env, value);
+  if ((tag & EMNAPI_TYPE_MASK) == 0) {
+    napi_status status = _emnapi_typeof(env, value, result);
+    if (status == napi_ok && (tag & EMNAPI_TYPE_OBJECT) != 0) {
+      // the JS call may have grown the table, so look the slot up again
+      uint8_t* slot = emnapi_type_slot(env, value);
+      if (slot != NULL && *slot == tag) *slot = tag | (uint8_t) (*result + 1);
+    }
+    return status;
+  }
+  *result = (napi_valuetype) ((tag & EMNAPI_TYPE_MASK) - 1);
+  return emnapi_clear_last_error(env);
+}
+
+napi_status napi_is_array(napi_env env, napi_value value, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  uint8_t tag = emnapi_type_tag(env, value);
+  if (tag == 0) return _emnapi_is_array(env, value, result);
+  *result = (tag & EMNAPI_TYPE_ARRAY) != 0;
+  return emnapi_clear_last_error(env);
+}
+
+napi_status napi_is_typedarray(napi_env env, napi_value value, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  uint8_t tag = emnapi_type_tag(env, value);
+  if (tag == 0) return _emnapi_is_typedarray(env, value, result);
+  *result = (tag & EMNAPI_TYPE_TYPEDARRAY) != 0;
+  return emnapi_clear_last_error(env);
+}
+
+#endif
+
 #define PAGESIZE 65536
 
 napi_status napi_adjust_external_memory(napi_env env,
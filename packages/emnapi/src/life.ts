@@ -5,7 +5,7 @@ function napi_open_handle_scope (env: napi_env, result: Pointer<napi_handle_scop
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const scope = emnapiCtx.openScope(envObject)
   $from64('result')
-  $makeSetValue('result', 0, 'scope.id', '*')
+  $makeSetValue('result', 0, 'scope', '*')
   return envObject.clearLastError()
 }
 
@@ -28,7 +28,7 @@ function napi_open_escapable_handle_scope (env: napi_env, result: Pointer<napi_e
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const scope = emnapiCtx.openScope(envObject)
   $from64('result')
-  $makeSetValue('result', 0, 'scope.id', '*')
+  $makeSetValue('result', 0, 'scope', '*')
   return envObject.clearLastError()
 }
 
@@ -50,14 +50,16 @@ function napi_escape_handle (env: napi_env, scope: napi_escapable_handle_scope,
   $CHECK_ARG!(envObject, scope)
   $CHECK_ARG!(envObject, escapee)
   $CHECK_ARG!(envObject, result)
-  const scopeObject = emnapiCtx.scopeStore.get(scope)!
-  if (!scopeObject.escapeCalled()) {
+  const scopeStore = emnapiCtx.scopeStore
+  if (!scopeStore.has(scope)) {
+    return envObject.setLastError(napi_status.napi_invalid_arg)
+  }
+  if (!scopeStore.escapeCalled(scope)) {
     $from64('escapee')
     $from64('result')
 
-    const newHandle = scopeObject.escape(escapee)
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const value = newHandle ? newHandle.id : 0
+    const value = scopeStore.escape(scope, escapee)
     $makeSetValue('result', 0, 'value', '*')
     return envObject.clearLastError()
   }
@@ -75,14 +77,14 @@ function napi_create_reference (
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
 
-  const handle = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   if (envObject.moduleApiVersion !== Version.NAPI_VERSION_EXPERIMENTAL) {
-    if (!(handle.isObject() || handle.isFunction() || handle.isSymbol())) {
+    if (!(emnapiCtx.isReferenceType(jsValue) || typeof jsValue === 'symbol')) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
   }
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const ref = emnapiCtx.createReference(envObject, handle.id, initial_refcount >>> 0, Ownership.kUserland as any)
+  const ref = emnapiCtx.createReference(envObject, value, initial_refcount >>> 0, Ownership.kUserland as any)
   $from64('result')
   $makeSetValue('result', 0, 'ref.id', '*')
   return envObject.clearLastError()
@@ -95,7 +97,9 @@ function napi_delete_reference (
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, ref)
-  emnapiCtx.refStore.get(ref)!.dispose()
+  const reference = emnapiCtx.refStore.get(ref)
+  if (!reference) return envObject.setLastError(napi_status.napi_invalid_arg)
+  reference.dispose()
   return envObject.clearLastError()
 }
 
@@ -107,8 +111,10 @@ function napi_reference_ref (
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, ref)
+  const reference = emnapiCtx.refStore.get(ref)
+  if (!reference) return envObject.setLastError(napi_status.napi_invalid_arg)
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const count = emnapiCtx.refStore.get(ref)!.ref()
+  const count = reference.ref()
   if (result) {
     $from64('result')
     $makeSetValue('result', 0, 'count', 'u32')
@@ -124,7 +130,8 @@ function napi_reference_unref (
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, ref)
-  const reference = emnapiCtx.refStore.get(ref)!
+  const reference = emnapiCtx.refStore.get(ref)
+  if (!reference) return envObject.setLastError(napi_status.napi_invalid_arg)
   const refcount = reference.refCount()
 
   if (refcount === 0) {
@@ -148,7 +155,8 @@ function napi_get_reference_value (
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, ref)
   $CHECK_ARG!(envObject, result)
-  const reference = emnapiCtx.refStore.get(ref)!
+  const reference = emnapiCtx.refStore.get(ref)
+  if (!reference) return envObject.setLastError(napi_status.napi_invalid_arg)
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const handleId = reference.get()
   $from64('result')
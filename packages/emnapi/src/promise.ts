@@ -16,7 +16,7 @@ function napi_create_promise (env: napi_env, deferred: Pointer<napi_deferred>, p
     $from64('promise')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = emnapiCtx.addToCurrentScope(p).id
+    value = emnapiCtx.addToCurrentScope(p)
     $makeSetValue('promise', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -26,8 +26,9 @@ function napi_resolve_deferred (env: napi_env, deferred: napi_deferred, resoluti
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, deferred)
     $CHECK_ARG!(envObject, resolution)
-    const deferredObject = emnapiCtx.deferredStore.get(deferred)!
-    deferredObject.resolve(emnapiCtx.handleStore.get(resolution)!.value)
+    const deferredObject = emnapiCtx.deferredStore.get(deferred)
+    if (!deferredObject) return envObject.setLastError(napi_status.napi_invalid_arg)
+    deferredObject.resolve(emnapiCtx.handleStore.get(resolution))
     return envObject.getReturnStatus()
   })
 }
@@ -36,8 +37,9 @@ function napi_reject_deferred (env: napi_env, deferred: napi_deferred, resolutio
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, deferred)
     $CHECK_ARG!(envObject, resolution)
-    const deferredObject = emnapiCtx.deferredStore.get(deferred)!
-    deferredObject.reject(emnapiCtx.handleStore.get(resolution)!.value)
+    const deferredObject = emnapiCtx.deferredStore.get(deferred)
+    if (!deferredObject) return envObject.setLastError(napi_status.napi_invalid_arg)
+    deferredObject.reject(emnapiCtx.handleStore.get(resolution))
     return envObject.getReturnStatus()
   })
 }
@@ -47,10 +49,10 @@ function napi_is_promise (env: napi_env, value: napi_value, is_promise: Pointer<
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, is_promise)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('is_promise')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isPromise() ? 1 : 0
+  const r = (jsValue instanceof Promise) ? 1 : 0
   $makeSetValue('is_promise', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -12,13 +12,13 @@ function _napi_get_all_property_names (
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, result)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let obj: any
     try {
-      obj = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      obj = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
@@ -127,7 +127,7 @@ function _napi_get_all_property_names (
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = emnapiCtx.addToCurrentScope(ret).id
+    value = emnapiCtx.addToCurrentScope(ret)
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -149,11 +149,11 @@ function napi_set_property (env: napi_env, object: napi_value, key: napi_value,
     $CHECK_ARG!(envObject, key)
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (!(h.isObject() || h.isFunction())) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    h.value[emnapiCtx.handleStore.get(key)!.value] = emnapiCtx.handleStore.get(value)!.value
+    jsObject[emnapiCtx.handleStore.get(key)] = emnapiCtx.handleStore.get(value)
     return envObject.getReturnStatus()
   })
 }
@@ -166,18 +166,18 @@ function napi_has_property (env: napi_env, object: napi_value, key: napi_value,
     $CHECK_ARG!(envObject, key)
     $CHECK_ARG!(envObject, result)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     $from64('result')
-    r = (emnapiCtx.handleStore.get(key)!.value in v) ? 1 : 0
+    r = (emnapiCtx.handleStore.get(key) in v) ? 1 : 0
     $makeSetValue('result', 0, 'r', 'i8')
     return envObject.getReturnStatus()
   })
@@ -191,19 +191,19 @@ function napi_get_property (env: napi_env, object: napi_value, key: napi_value,
     $CHECK_ARG!(envObject, key)
     $CHECK_ARG!(envObject, result)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     $from64('result')
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = envObject.ensureHandleId(v[emnapiCtx.handleStore.get(key)!.value])
+    value = envObject.ensureHandleId(v[emnapiCtx.handleStore.get(key)])
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -216,16 +216,16 @@ function napi_delete_property (env: napi_env, object: napi_value, key: napi_valu
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, key)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (!(h.isObject() || h.isFunction())) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    const propertyKey = emnapiCtx.handleStore.get(key)!.value
+    const propertyKey = emnapiCtx.handleStore.get(key)
     if (emnapiCtx.feature.supportReflect) {
-      r = Reflect.deleteProperty(h.value, propertyKey)
+      r = Reflect.deleteProperty(jsObject, propertyKey)
     } else {
       try {
-        r = delete h.value[propertyKey]
+        r = delete jsObject[propertyKey]
       } catch (_) {
         r = false
       }
@@ -246,21 +246,21 @@ function napi_has_own_property (env: napi_env, object: napi_value, key: napi_val
     $CHECK_ARG!(envObject, key)
     $CHECK_ARG!(envObject, result)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    const prop = emnapiCtx.handleStore.get(key)!.value
+    const prop = emnapiCtx.handleStore.get(key)
     if (typeof prop !== 'string' && typeof prop !== 'symbol') {
       return envObject.setLastError(napi_status.napi_name_expected)
     }
-    r = Object.prototype.hasOwnProperty.call(v, emnapiCtx.handleStore.get(key)!.value)
+    r = Object.prototype.hasOwnProperty.call(v, emnapiCtx.handleStore.get(key))
     $from64('result')
     $makeSetValue('result', 0, 'r ? 1 : 0', 'i8')
     return envObject.getReturnStatus()
@@ -271,15 +271,15 @@ function napi_set_named_property (env: napi_env, object: napi_value, cname: cons
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (!(h.isObject() || h.isFunction())) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     if (!cname) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
     $from64('cname')
-    emnapiCtx.handleStore.get(object)!.value[emnapiString.UTF8ToString(cname, -1)] = emnapiCtx.handleStore.get(value)!.value
+    emnapiCtx.handleStore.get(object)[emnapiString.propertyKeyFromUTF8(cname, -1)] = emnapiCtx.handleStore.get(value)
     return envObject.getReturnStatus()
   })
 }
@@ -294,20 +294,20 @@ function napi_has_named_property (env: napi_env, object: napi_value, utf8name: c
     if (!utf8name) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     $from64('utf8name')
     $from64('result')
 
-    r = emnapiString.UTF8ToString(utf8name, -1) in v
+    r = emnapiString.propertyKeyFromUTF8(utf8name, -1) in v
     $makeSetValue('result', 0, 'r ? 1 : 0', 'i8')
     return envObject.getReturnStatus()
   })
@@ -323,13 +323,13 @@ function napi_get_named_property (env: napi_env, object: napi_value, utf8name: c
     if (!utf8name) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
@@ -337,7 +337,7 @@ function napi_get_named_property (env: napi_env, object: napi_value, utf8name: c
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = envObject.ensureHandleId(v[emnapiString.UTF8ToString(utf8name, -1)])
+    value = envObject.ensureHandleId(v[emnapiString.propertyKeyFromUTF8(utf8name, -1)])
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -347,11 +347,11 @@ function napi_set_element (env: napi_env, object: napi_value, index: uint32_t, v
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (!(h.isObject() || h.isFunction())) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    h.value[index >>> 0] = emnapiCtx.handleStore.get(value)!.value
+    jsObject[index >>> 0] = emnapiCtx.handleStore.get(value)
     return envObject.getReturnStatus()
   })
 }
@@ -363,13 +363,13 @@ function napi_has_element (env: napi_env, object: napi_value, index: uint32_t, r
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, result)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
@@ -387,13 +387,13 @@ function napi_get_element (env: napi_env, object: napi_value, index: uint32_t, r
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, result)
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (h.value == null) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (jsObject == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     let v: any
     try {
-      v = h.isObject() || h.isFunction() ? h.value : Object(h.value)
+      v = emnapiCtx.isReferenceType(jsObject) ? jsObject : Object(jsObject)
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
@@ -411,15 +411,15 @@ function napi_delete_element (env: napi_env, object: napi_value, index: uint32_t
 
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, object)
-    const h = emnapiCtx.handleStore.get(object)!
-    if (!(h.isObject() || h.isFunction())) {
+    const jsObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     if (emnapiCtx.feature.supportReflect) {
-      r = Reflect.deleteProperty(h.value, index >>> 0)
+      r = Reflect.deleteProperty(jsObject, index >>> 0)
     } else {
       try {
-        r = delete h.value[index >>> 0]
+        r = delete jsObject[index >>> 0]
       } catch (_) {
         r = false
       }
@@ -451,9 +451,8 @@ function napi_define_properties (
       if (!properties) return envObject.setLastError(napi_status.napi_invalid_arg)
     }
     if (!object) return envObject.setLastError(napi_status.napi_invalid_arg)
-    const h = emnapiCtx.handleStore.get(object)!
-    const maybeObject = h.value
-    if (!(h.isObject() || h.isFunction())) {
+    const maybeObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(maybeObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
 
@@ -473,12 +472,12 @@ function napi_define_properties (
       const data = $makeGetValue('propPtr', POINTER_SIZE * 7, '*')
 
       if (utf8Name) {
-        propertyName = emnapiString.UTF8ToString(utf8Name, -1)
+        propertyName = emnapiString.propertyKeyFromUTF8(utf8Name, -1)
       } else {
         if (!name) {
           return envObject.setLastError(napi_status.napi_name_expected)
         }
-        propertyName = emnapiCtx.handleStore.get(name)!.value
+        propertyName = emnapiCtx.handleStore.get(name)
         if (typeof propertyName !== 'string' && typeof propertyName !== 'symbol') {
           return envObject.setLastError(napi_status.napi_name_expected)
         }
@@ -492,9 +491,8 @@ function napi_define_properties (
 function napi_object_freeze (env: napi_env, object: napi_value): napi_status {
   return $PREAMBLE!(env, (envObject) => {
     if (!object) return envObject.setLastError(napi_status.napi_invalid_arg)
-    const h = emnapiCtx.handleStore.get(object)!
-    const maybeObject = h.value
-    if (!(h.isObject() || h.isFunction())) {
+    const maybeObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(maybeObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     Object.freeze(maybeObject)
@@ -505,9 +503,8 @@ function napi_object_freeze (env: napi_env, object: napi_value): napi_status {
 function napi_object_seal (env: napi_env, object: napi_value): napi_status {
   return $PREAMBLE!(env, (envObject) => {
     if (!object) return envObject.setLastError(napi_status.napi_invalid_arg)
-    const h = emnapiCtx.handleStore.get(object)!
-    const maybeObject = h.value
-    if (!(h.isObject() || h.isFunction())) {
+    const maybeObject = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(maybeObject)) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     Object.seal(maybeObject)
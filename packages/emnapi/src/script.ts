@@ -8,12 +8,12 @@ function napi_run_script (env: napi_env, script: napi_value, result: Pointer<nap
   $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, script)
     $CHECK_ARG!(envObject, result)
-    const v8Script = emnapiCtx.handleStore.get(script)!
-    if (!v8Script.isString()) {
+    const v8Script = emnapiCtx.handleStore.get(script)
+    if (typeof v8Script !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
-    const g: typeof globalThis = emnapiCtx.handleStore.get(GlobalHandle.GLOBAL)!.value
-    const ret = g.eval(v8Script.value)
+    const g: typeof globalThis = emnapiCtx.handleStore.get(GlobalHandle.GLOBAL)
+    const ret = g.eval(v8Script)
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
@@ -7,6 +7,20 @@ declare interface Decoder {
 var emnapiString = {
   utf8Decoder: undefined! as Decoder,
   utf16Decoder: undefined! as Decoder,
+  utf8Encoder: undefined as TextEncoder | undefined,
+  // unshared staging buffer for TextEncoder and TextDecoder
+  // when memory is a SharedArrayBuffer
+  staging: undefined as Uint8Array | undefined,
+  // decoded keys of immutable strings in [keyCacheBegin, keyCacheEnd) by address,
+  // the range belongs to this module's memory so it is shared by all its envs
+  keyCacheBegin: 0,
+  keyCacheEnd: 0,
+  keyCache: undefined! as Map<number, { length: number, key: string }>,
+  // external strings are cached per env in Env.externalStrings, their
+  // buffers stay owned until the entry is evicted or the env is torn down
+  externalStringsMaxBytes: 1 << 20,
+  // buffers handed over for one cached string before the older ones are released
+  externalStringOwnersLimit: 64,
   init () {
 // #if !TEXTDECODER || TEXTDECODER == 1
     const fallbackDecoder = {
@@ -100,17 +114,23 @@ var emnapiString = {
     utf16Decoder = new TextDecoder('utf-16le')
 // #endif
     emnapiString.utf16Decoder = utf16Decoder
+    if (typeof TextEncoder === 'function' && typeof TextEncoder.prototype.encodeInto === 'function') {
+      emnapiString.utf8Encoder = new TextEncoder()
+    }
+    emnapiString.keyCache = new Map()
   },
+  // lone surrogates count as U+FFFD like TextEncoder
   lengthBytesUTF8 (str: string): number {
     let c: number
     let len = 0
-    for (let i = 0; i < str.length; ++i) {
+    const length = str.length
+    for (let i = 0; i < length; ++i) {
       c = str.charCodeAt(i)
       if (c <= 0x7F) {
         len++
       } else if (c <= 0x7FF) {
         len += 2
-      } else if (c >= 0xD800 && c <= 0xDFFF) {
+      } else if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length && (str.charCodeAt(i + 1) & 0xFC00) === 0xDC00) {
         len += 4; ++i
       } else {
         len += 3
@@ -118,6 +138,35 @@ var emnapiString = {
     }
     return len
   },
+  // a long string is encoded once for its handle, and the copy
+  // that usually follows writes those bytes
+  queryLengthUTF8 (value: napi_value, str: string): number {
+    const encoder = emnapiString.utf8Encoder
+    if (encoder === undefined || str.length < 256) {
+      return emnapiString.lengthBytesUTF8(str)
+    }
+    const bytes = encoder.encode(str)
+    emnapiCtx.handleStore.setUTF8Bytes(value, bytes)
+    return bytes.length
+  },
+  copyUTF8 (value: napi_value, str: string, outPtr: number, maxBytesToWrite: number): number {
+    const bytes = emnapiCtx.handleStore.takeUTF8Bytes(value)
+    if (bytes === undefined) {
+      return emnapiString.stringToUTF8(str, outPtr, maxBytesToWrite)
+    }
+    if (!(maxBytesToWrite > 0)) { return 0 }
+    outPtr >>>= 0
+    let n = bytes.length
+    if (n > maxBytesToWrite - 1) {
+      n = maxBytesToWrite - 1
+      // do not split a code point
+      while (n > 0 && (bytes[n] & 0xC0) === 0x80) --n
+    }
+    const HEAPU8 = new Uint8Array(wasmMemory.buffer)
+    HEAPU8.set(n === bytes.length ? bytes : bytes.subarray(0, n), outPtr)
+    HEAPU8[outPtr + n] = 0
+    return n
+  },
   UTF8ToString (ptr: void_p, length: int): string {
     if (!ptr || !length) return ''
     ptr >>>= 0
@@ -154,22 +203,82 @@ var emnapiString = {
       }
       return str
     }
+    if (length <= 1024 && typeof SharedArrayBuffer === 'function' && HEAPU8.buffer instanceof SharedArrayBuffer) {
+      // ASCII needs neither a decoder nor a copy out of shared memory
+      let idx = ptr
+      while (idx < end && !(HEAPU8[idx] & 0x80)) ++idx
+      if (idx === end) return String.fromCharCode.apply(null, HEAPU8.subarray(ptr, end) as any)
+    }
 // #endif
-    return emnapiString.utf8Decoder.decode($getUnsharedTextDecoderView('HEAPU8', 'ptr', 'end') as Uint8Array)
+    return emnapiString.utf8Decoder.decode(emnapiString.decoderView(HEAPU8, ptr, end))
   },
   stringToUTF8 (str: string, outPtr: number, maxBytesToWrite: number): number {
+    if (!(maxBytesToWrite > 0)) { return 0 }
+    outPtr >>>= 0
     const HEAPU8 = new Uint8Array(wasmMemory.buffer)
+    const length = str.length
+    // the last byte is reserved for the null terminator
+    const endIdx = outPtr + maxBytesToWrite - 1
     let outIdx = outPtr
-    outIdx >>>= 0
-    if (!(maxBytesToWrite > 0)) { return 0 }
+    let i = 0
+
+    for (; i < length && outIdx < endIdx; ++i) {
+      const c = str.charCodeAt(i)
+      if (c > 0x7F) break
+      HEAPU8[outIdx++] = c
+    }
 
-    var startIdx = outIdx
-    var endIdx = outIdx + maxBytesToWrite - 1
-    for (var i = 0; i < str.length; ++i) {
-      var u = str.charCodeAt(i)
+    if (i < length && outIdx < endIdx) {
+      const encoder = emnapiString.utf8Encoder
+      if (encoder !== undefined && length - i >= 64) {
+        outIdx += emnapiString.encodeInto(encoder, HEAPU8, i === 0 ? str : str.slice(i), outIdx, endIdx)
+      } else {
+        outIdx = emnapiString.encodeUTF8Slow(HEAPU8, str, i, outIdx, endIdx)
+      }
+    }
+
+    HEAPU8[outIdx] = 0
+    return outIdx - outPtr
+  },
+  getStaging (size: number): Uint8Array {
+    let staging = emnapiString.staging
+    if (staging === undefined || staging.length < size) {
+      staging = new Uint8Array(Math.max(size, staging === undefined ? 1024 : staging.length * 2))
+      // do not hold on to buffers of huge strings
+      if (staging.length <= 0x100000) emnapiString.staging = staging
+    }
+    return staging.subarray(0, size)
+  },
+  // decoders reject views of a SharedArrayBuffer
+  decoderView (HEAPU8: Uint8Array, start: number, end: number): Uint8Array {
+    if (typeof SharedArrayBuffer === 'function' && HEAPU8.buffer instanceof SharedArrayBuffer) {
+      const staging = emnapiString.getStaging(end - start)
+      staging.set(HEAPU8.subarray(start, end))
+      return staging
+    }
+    return HEAPU8.subarray(start, end)
+  },
+  encodeInto (encoder: TextEncoder, HEAPU8: Uint8Array, str: string, outIdx: number, endIdx: number): number {
+    if (typeof SharedArrayBuffer === 'function' && HEAPU8.buffer instanceof SharedArrayBuffer) {
+      const staging = emnapiString.getStaging(Math.min(endIdx - outIdx, str.length * 3))
+      const written = encoder.encodeInto(str, staging).written!
+      HEAPU8.set(staging.subarray(0, written), outIdx)
+      return written
+    }
+    return encoder.encodeInto(str, HEAPU8.subarray(outIdx, endIdx)).written!
+  },
+  encodeUTF8Slow (HEAPU8: Uint8Array, str: string, i: number, outIdx: number, endIdx: number): number {
+    const length = str.length
+    for (; i < length; ++i) {
+      let u = str.charCodeAt(i)
       if (u >= 0xD800 && u <= 0xDFFF) {
-        var u1 = str.charCodeAt(++i)
-        u = 0x10000 + ((u & 0x3FF) << 10) | (u1 & 0x3FF)
+        const u1 = i + 1 < length ? str.charCodeAt(i + 1) : 0
+        if (u <= 0xDBFF && (u1 & 0xFC00) === 0xDC00) {
+          u = 0x10000 + ((u & 0x3FF) << 10) | (u1 & 0x3FF)
+          ++i
+        } else {
+          u = 0xFFFD
+        }
       }
       if (u <= 0x7F) {
         if (outIdx >= endIdx) break
@@ -191,8 +300,35 @@ var emnapiString = {
         HEAPU8[outIdx++] = 0x80 | (u & 63)
       }
     }
-    HEAPU8[outIdx] = 0
-    return outIdx - startIdx
+    return outIdx
+  },
+  latin1ToString (ptr: number, length: number): string {
+    if (!ptr || !length) return ''
+    ptr >>>= 0
+    const HEAPU8 = new Uint8Array(wasmMemory.buffer)
+    let end = ptr
+    if (length === -1) {
+      for (; HEAPU8[end];) ++end
+    } else {
+      end = ptr + (length >>> 0)
+    }
+    // TextDecoder('latin1') is windows-1252 and maps 0x80-0x9F differently
+    let str = ''
+    for (let i = ptr; i < end; i += 0x1000) {
+      str += String.fromCharCode.apply(null, HEAPU8.subarray(i, Math.min(i + 0x1000, end)) as any)
+    }
+    return str
+  },
+  stringToLatin1 (str: string, outPtr: number, maxBytesToWrite: number): number {
+    if (!(maxBytesToWrite > 0)) { return 0 }
+    outPtr >>>= 0
+    const copied = Math.min(str.length, maxBytesToWrite - 1)
+    const view = new Uint8Array(wasmMemory.buffer, outPtr, copied + 1)
+    for (let i = 0; i < copied; ++i) {
+      view[i] = str.charCodeAt(i)
+    }
+    view[copied] = 0
+    return copied
   },
   UTF16ToString (ptr: number, length: number): string {
     if (!ptr || !length) return ''
@@ -208,13 +344,12 @@ var emnapiString = {
     }
 // #if TEXTDECODER != 2
     length = end - ptr
-    if (length <= 32) {
+    if (length <= 32 || (length <= 2048 && typeof SharedArrayBuffer === 'function' && wasmMemory.buffer instanceof SharedArrayBuffer)) {
       return String.fromCharCode.apply(null, new Uint16Array(wasmMemory.buffer, ptr, length / 2) as any)
     }
 // #endif
-    // eslint-disable-next-line @typescript-eslint/no-unused-vars
     const HEAPU8 = new Uint8Array(wasmMemory.buffer)
-    return emnapiString.utf16Decoder.decode($getUnsharedTextDecoderView('HEAPU8', 'ptr', 'end') as Uint8Array)
+    return emnapiString.utf16Decoder.decode(emnapiString.decoderView(HEAPU8, ptr, end))
   },
   stringToUTF16 (str: string, outPtr: number, maxBytesToWrite: number): number {
     if (maxBytesToWrite === undefined) {
@@ -233,6 +368,19 @@ var emnapiString = {
     $makeSetValue('outPtr', 0, '0', 'i16')
     return outPtr - startPtr
   },
+  propertyKeyFromUTF8 (ptr: void_p, length: int): string {
+    if (ptr < emnapiString.keyCacheBegin || ptr >= emnapiString.keyCacheEnd) {
+      return emnapiString.UTF8ToString(ptr, length)
+    }
+    const entry = emnapiString.keyCache.get(ptr)
+    if (entry !== undefined && entry.length === length) {
+      return entry.key
+    }
+    // an address looked up with another length replaces its entry
+    const key = emnapiString.UTF8ToString(ptr, length)
+    emnapiString.keyCache.set(ptr, { length, key })
+    return key
+  },
   newString (env: napi_env,
     str: number,
     length: size_t,
@@ -256,10 +404,34 @@ var emnapiString = {
     const strValue = stringMaker(autoLength, sizelength)
     $from64('result')
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const value = emnapiCtx.addToCurrentScope(strValue).id
+    const value = emnapiCtx.addToCurrentScope(strValue)
     $makeSetValue('result', 0, 'value', '*')
     return envObject.clearLastError()
   },
+  releaseExternalString (envObject: Env, key: string, entry: IExternalString): void {
+    envObject.externalStrings.delete(key)
+    envObject.externalStringBytes -= entry.bytes
+    emnapiString.releaseExternalStringOwners(entry)
+  },
+  releaseExternalStringOwners (entry: IExternalString): void {
+    const finalizers = entry.finalizers
+    for (let i = 0; i < finalizers.length; ++i) {
+      finalizers[i].finalize()
+    }
+    finalizers.length = 0
+  },
+  externalStringMatches (value: string, str: number, length: number, encoding: 'latin1' | 'utf16'): boolean {
+    const n = value.length
+    if (length !== -1 && (length >>> 0) !== n) return false
+    str >>>= 0
+    const view = encoding === 'latin1'
+      ? new Uint8Array(wasmMemory.buffer, str, length === -1 ? n + 1 : n)
+      : new Uint16Array(wasmMemory.buffer, str, length === -1 ? n + 1 : n)
+    for (let i = 0; i < n; ++i) {
+      if (view[i] !== value.charCodeAt(i)) return false
+    }
+    return length !== -1 || view[n] === 0
+  },
   newExternalString (
     env: napi_env,
     str: number,
@@ -269,16 +441,68 @@ var emnapiString = {
     result: Pointer<napi_value>,
     copied: Pointer<bool>,
     createApi: (env: napi_env, str: number, length: size_t, result: Pointer<napi_value>) => napi_status,
-    stringMaker: (autoLength: boolean, sizeLength: number) => string
+    encoding: 'latin1' | 'utf16'
   ) {
-    const status = createApi(env, str, length, result)
-    if (status === napi_status.napi_ok) {
-      if (copied) {
-        $makeSetValue('copied', 0, '1', 'i8')
+    const envObject = env ? emnapiCtx.envStore.get(env) : undefined
+    if (!envObject || !str || !result) {
+      return createApi(env, str, length, result)
+    }
+    // A JS string never aliases wasm memory, so the value is always decoded
+    // once. What the cache saves is decoding the same buffer again, and a hit
+    // is only trusted after the characters are compared with the buffer,
+    // since the address may have been reused for other contents.
+    const cache = envObject.externalStrings
+    const key = encoding + ':' + str + ':' + length
+    let entry = cache.get(key)
+    let status: napi_status
+    if (entry !== undefined && !emnapiString.externalStringMatches(entry.value, str, length, encoding)) {
+      emnapiString.releaseExternalString(envObject, key, entry)
+      entry = undefined
+    }
+    if (entry !== undefined) {
+      cache.delete(key)
+      cache.set(key, entry)
+      // the cached value no longer needs memory, so old owners can go
+      if (entry.finalizers.length >= emnapiString.externalStringOwnersLimit) {
+        emnapiString.releaseExternalStringOwners(entry)
+      }
+      const value = entry.value
+      status = emnapiString.newString(env, str, length, result, () => value)
+    } else {
+      status = createApi(env, str, length, result)
+      if (status !== napi_status.napi_ok) return status
+      $from64('result')
+      const handle = $makeGetValue('result', 0, '*')
+      const value: string = emnapiCtx.handleStore.get(handle)
+      const bytes = value.length * (encoding === 'latin1' ? 1 : 2)
+      if (bytes > emnapiString.externalStringsMaxBytes) {
+        // too large to keep, so it is reported as copied
+        if (copied) {
+          $from64('copied')
+          $makeSetValue('copied', 0, '1', 'i8')
+        }
+        if (finalize_callback) {
+          envObject.callFinalizer(finalize_callback, str, finalize_hint)
+        }
+        return status
+      }
+      entry = { value, bytes, finalizers: [] }
+      cache.set(key, entry)
+      envObject.externalStringBytes += bytes
+      // the budget is in bytes, so one large buffer can push out many small ones
+      while (envObject.externalStringBytes > emnapiString.externalStringsMaxBytes) {
+        const oldest = cache.keys().next().value!
+        emnapiString.releaseExternalString(envObject, oldest, cache.get(oldest)!)
       }
+    }
+    if (status === napi_status.napi_ok) {
+      // the buffer is released with the entry, like a string the engine keeps
       if (finalize_callback) {
-        const envObject = emnapiCtx.envStore.get(env)!
-        envObject.callFinalizer(finalize_callback, str, finalize_hint)
+        entry.finalizers.push(emnapiCtx.createFinalizer(envObject, finalize_callback, str, finalize_hint))
+      }
+      if (copied) {
+        $from64('copied')
+        $makeSetValue('copied', 0, '0', 'i8')
       }
     }
     return status
@@ -463,7 +463,7 @@ const emnapiTSFN = {
         if (emnapiNodeBinding) {
           const resource = emnapiTSFN.getResource(func)
           const resource_value = emnapiCtx.refStore.get(resource)!.get()
-          const resourceObject = emnapiCtx.handleStore.get(resource_value)!.value
+          const resourceObject = emnapiCtx.handleStore.get(resource_value)
           const view = new DataView(wasmMemory.buffer)
           const asyncId = view.getFloat64(func + emnapiTSFN.offset.async_id, true)
           const triggerAsyncId = view.getFloat64(func + emnapiTSFN.offset.trigger_async_id, true)
@@ -558,7 +558,7 @@ const emnapiTSFN = {
             const context = emnapiTSFN.getContext(func)
             $makeDynCall('vpppp', 'callJsCb')($to64('env'), $to64('js_callback'), $to64('context'), $to64('data'))
           } else {
-            const jsCallback = js_callback ? emnapiCtx.handleStore.get(js_callback)!.value : null
+            const jsCallback = js_callback ? emnapiCtx.handleStore.get(js_callback) : null
             if (typeof jsCallback === 'function') {
               jsCallback()
             }
@@ -570,7 +570,7 @@ const emnapiTSFN = {
         if (emnapiNodeBinding) {
           const resource = emnapiTSFN.getResource(func)
           const resource_value = emnapiCtx.refStore.get(resource)!.get()
-          const resourceObject = emnapiCtx.handleStore.get(resource_value)!.value
+          const resourceObject = emnapiCtx.handleStore.get(resource_value)
           const view = new DataView(wasmMemory.buffer)
           emnapiNodeBinding.node.makeCallback(resourceObject, f, [], {
             asyncId: view.getFloat64(func + emnapiTSFN.offset.async_id, true),
@@ -662,7 +662,7 @@ function _napi_create_threadsafe_function (
   if (!func) {
     $CHECK_ARG!(envObject, call_js_cb)
   } else {
-    const funcValue = emnapiCtx.handleStore.get(func)!.value
+    const funcValue = emnapiCtx.handleStore.get(func)
     if (typeof funcValue !== 'function') {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
@@ -672,7 +672,7 @@ function _napi_create_threadsafe_function (
 
   let asyncResourceObject: any
   if (async_resource) {
-    asyncResourceObject = emnapiCtx.handleStore.get(async_resource)!.value
+    asyncResourceObject = emnapiCtx.handleStore.get(async_resource)
     if (asyncResourceObject == null) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
@@ -682,7 +682,7 @@ function _napi_create_threadsafe_function (
   }
   const resource = envObject.ensureHandleId(asyncResourceObject)
 
-  let asyncResourceName = emnapiCtx.handleStore.get(async_resource_name)!.value
+  let asyncResourceName = emnapiCtx.handleStore.get(async_resource_name)
   if (typeof asyncResourceName === 'symbol') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
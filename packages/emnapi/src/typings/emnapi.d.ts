@@ -1,7 +1,9 @@
 declare type Env = import('../../../runtime/lib/typings/index').Env
 declare type NodeEnv = import('../../../runtime/lib/typings/index').NodeEnv
-declare type Handle<S> = import('../../../runtime/lib/typings/index').Handle<S>
 declare type Context = import('../../../runtime/lib/typings/index').Context
 declare type Reference = import('../../../runtime/lib/typings/index').Reference
+declare type RefBase = import('../../../runtime/lib/typings/index').RefBase
+declare type ILastError = import('../../../runtime/lib/typings/index').ILastError
+declare type IExternalString = import('../../../runtime/lib/typings/index').IExternalString
 
 declare type NodeBinding = typeof import('../../../node/index')
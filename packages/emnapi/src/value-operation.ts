@@ -3,32 +3,32 @@ function napi_typeof (env: napi_env, value: napi_value, result: Pointer<napi_val
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const v = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   let r: napi_valuetype
-  if (v.isNumber()) {
+  if (typeof jsValue === 'number') {
     r = napi_valuetype.napi_number
-  } else if (v.isBigInt()) {
+  } else if (typeof jsValue === 'bigint') {
     r = napi_valuetype.napi_bigint
-  } else if (v.isString()) {
+  } else if (typeof jsValue === 'string') {
     r = napi_valuetype.napi_string
-  } else if (v.isFunction()) {
+  } else if (typeof jsValue === 'function') {
   // This test has to come before IsObject because IsFunction
   // implies IsObject
     r = napi_valuetype.napi_function
-  } else if (v.isExternal()) {
+  } else if (emnapiCtx.isExternal(jsValue)) {
   // This test has to come before IsObject because IsExternal
   // implies IsObject
     r = napi_valuetype.napi_external
-  } else if (v.isObject()) {
+  } else if (typeof jsValue === 'object' && jsValue !== null) {
     r = napi_valuetype.napi_object
-  } else if (v.isBoolean()) {
+  } else if (typeof jsValue === 'boolean') {
     r = napi_valuetype.napi_boolean
-  } else if (v.isUndefined()) {
+  } else if (jsValue === undefined) {
     r = napi_valuetype.napi_undefined
-  } else if (v.isSymbol()) {
+  } else if (typeof jsValue === 'symbol') {
     r = napi_valuetype.napi_symbol
-  } else if (v.isNull()) {
+  } else if (jsValue === null) {
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
     r = napi_valuetype.napi_null
   } else {
@@ -48,10 +48,10 @@ function napi_coerce_to_bool (env: napi_env, value: napi_value, result: Pointer<
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, result)
-    const handle = emnapiCtx.handleStore.get(value)!
+    const jsValue = emnapiCtx.handleStore.get(value)
     $from64('result')
 
-    v = handle.value ? GlobalHandle.TRUE : GlobalHandle.FALSE
+    v = jsValue ? GlobalHandle.TRUE : GlobalHandle.FALSE
     $makeSetValue('result', 0, 'v', '*')
     return envObject.getReturnStatus()
   })
@@ -64,14 +64,14 @@ function napi_coerce_to_number (env: napi_env, value: napi_value, result: Pointe
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, result)
-    const handle = emnapiCtx.handleStore.get(value)!
-    if (handle.isBigInt()) {
+    const jsValue = emnapiCtx.handleStore.get(value)
+    if (typeof jsValue === 'bigint') {
       throw new TypeError('Cannot convert a BigInt value to a number')
     }
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    v = emnapiCtx.addToCurrentScope(Number(handle.value)).id
+    v = emnapiCtx.addToCurrentScope(Number(jsValue))
     $makeSetValue('result', 0, 'v', '*')
     return envObject.getReturnStatus()
   })
@@ -84,14 +84,14 @@ function napi_coerce_to_object (env: napi_env, value: napi_value, result: Pointe
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, result)
-    const handle = emnapiCtx.handleStore.get(value)!
-    if (handle.value == null) {
+    const jsValue = emnapiCtx.handleStore.get(value)
+    if (jsValue == null) {
       throw new TypeError('Cannot convert undefined or null to object')
     }
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    v = envObject.ensureHandleId(Object(handle.value))
+    v = envObject.ensureHandleId(Object(jsValue))
     $makeSetValue('result', 0, 'v', '*')
     return envObject.getReturnStatus()
   })
@@ -104,14 +104,14 @@ function napi_coerce_to_string (env: napi_env, value: napi_value, result: Pointe
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, result)
-    const handle = emnapiCtx.handleStore.get(value)!
-    if (handle.isSymbol()) {
+    const jsValue = emnapiCtx.handleStore.get(value)
+    if (typeof jsValue === 'symbol') {
       throw new TypeError('Cannot convert a Symbol value to a string')
     }
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    v = emnapiCtx.addToCurrentScope(String(handle.value)).id
+    v = emnapiCtx.addToCurrentScope(String(jsValue))
     $makeSetValue('result', 0, 'v', '*')
     return envObject.getReturnStatus()
   })
@@ -127,12 +127,12 @@ function napi_instanceof (env: napi_env, object: napi_value, constructor: napi_v
     $CHECK_ARG!(envObject, constructor)
     $from64('result')
     $makeSetValue('result', 0, '0', 'i8')
-    const ctor = emnapiCtx.handleStore.get(constructor)!
-    if (!ctor.isFunction()) {
+    const ctor = emnapiCtx.handleStore.get(constructor)
+    if (typeof ctor !== 'function') {
       return envObject.setLastError(napi_status.napi_function_expected)
     }
-    const val = emnapiCtx.handleStore.get(object)!.value
-    const ret = val instanceof ctor.value
+    const val = emnapiCtx.handleStore.get(object)
+    const ret = val instanceof ctor
     r = ret ? 1 : 0
     $makeSetValue('result', 0, 'r', 'i8')
     return envObject.getReturnStatus()
@@ -144,10 +144,10 @@ function napi_is_array (env: napi_env, value: napi_value, result: Pointer<bool>)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isArray() ? 1 : 0
+  const r = Array.isArray(jsValue) ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -157,10 +157,10 @@ function napi_is_arraybuffer (env: napi_env, value: napi_value, result: Pointer<
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isArrayBuffer() ? 1 : 0
+  const r = (jsValue instanceof ArrayBuffer) ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -170,10 +170,10 @@ function napi_is_date (env: napi_env, value: napi_value, result: Pointer<bool>):
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isDate() ? 1 : 0
+  const r = (jsValue instanceof Date) ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -183,7 +183,7 @@ function napi_is_error (env: napi_env, value: napi_value, result: Pointer<bool>)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const val = emnapiCtx.handleStore.get(value)!.value
+  const val = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const r = (val instanceof Error) ? 1 : 0
@@ -196,10 +196,10 @@ function napi_is_typedarray (env: napi_env, value: napi_value, result: Pointer<b
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isTypedArray() ? 1 : 0
+  const r = emnapiCtx.isTypedArray(jsValue) ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -209,10 +209,10 @@ function napi_is_buffer (env: napi_env, value: napi_value, result: Pointer<bool>
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isBuffer() ? 1 : 0
+  const r = (typeof emnapiCtx.feature.Buffer === 'function' && emnapiCtx.feature.Buffer.isBuffer(jsValue)) ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -222,10 +222,10 @@ function napi_is_dataview (env: napi_env, value: napi_value, result: Pointer<boo
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const h = emnapiCtx.handleStore.get(value)!
+  const jsValue = emnapiCtx.handleStore.get(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = h.isDataView() ? 1 : 0
+  const r = (jsValue instanceof DataView) ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -238,8 +238,8 @@ function napi_strict_equals (env: napi_env, lhs: napi_value, rhs: napi_value, re
     $CHECK_ARG!(envObject, lhs)
     $CHECK_ARG!(envObject, rhs)
     $CHECK_ARG!(envObject, result)
-    const lv = emnapiCtx.handleStore.get(lhs)!.value
-    const rv = emnapiCtx.handleStore.get(rhs)!.value
+    const lv = emnapiCtx.handleStore.get(lhs)
+    const rv = emnapiCtx.handleStore.get(rhs)
     $from64('result')
     r = (lv === rv) ? 1 : 0
     $makeSetValue('result', 0, 'r', 'i8')
@@ -251,7 +251,7 @@ function napi_detach_arraybuffer (env: napi_env, arraybuffer: napi_value): napi_
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, arraybuffer)
-  const value = emnapiCtx.handleStore.get(arraybuffer)!.value
+  const value = emnapiCtx.handleStore.get(arraybuffer)
   if (!(value instanceof ArrayBuffer)) {
     if (typeof SharedArrayBuffer === 'function' && (value instanceof SharedArrayBuffer)) {
       return envObject.setLastError(napi_status.napi_detachable_arraybuffer_expected)
@@ -273,12 +273,12 @@ function napi_is_detached_arraybuffer (env: napi_env, arraybuffer: napi_value, r
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, arraybuffer)
     $CHECK_ARG!(envObject, result)
-    const h = emnapiCtx.handleStore.get(arraybuffer)!
+    const jsValue = emnapiCtx.handleStore.get(arraybuffer)
     $from64('result')
-    if (h.isArrayBuffer() && h.value.byteLength === 0) {
+    if ((jsValue instanceof ArrayBuffer) && jsValue.byteLength === 0) {
       try {
         // eslint-disable-next-line no-new
-        new Uint8Array(h.value as ArrayBuffer)
+        new Uint8Array(jsValue as ArrayBuffer)
       } catch (_) {
         $makeSetValue('result', 0, '1', 'i8')
         return envObject.getReturnStatus()
@@ -289,6 +289,127 @@ function napi_is_detached_arraybuffer (env: napi_env, arraybuffer: napi_value, r
   })
 }
 
+// mirrors the type of scope handles into wasm memory for js_native_api.c,
+// one byte per handle id, 0 means unknown, otherwise
+// (napi_valuetype + 1) | emnapiTypeTable.ARRAY | emnapiTypeTable.TYPEDARRAY.
+// Objects are recorded as emnapiTypeTable.OBJECT | flags without a type,
+// telling an external from an object may run proxy traps
+var emnapiTypeTable = {
+  ARRAY: 0x10,
+  TYPEDARRAY: 0x20,
+  OBJECT: 0x40,
+  // laid out as { uint8_t* types; uint32_t length; }
+  address: 0,
+  data: 0,
+  length: 0,
+  // ids beyond the table are left unknown until C asks for the table again,
+  // recording runs inside HandleStore.push() so it must not allocate
+  wantedLength: 0,
+  // %TypedArray%.prototype[Symbol.toStringTag] getter, a brand check without traps
+  typedArrayTag: undefined as ((this: any) => string | undefined) | undefined,
+  record (id: number, value: any): void {
+    if (id >= emnapiTypeTable.length) {
+      if (id >= emnapiTypeTable.wantedLength) emnapiTypeTable.wantedLength = id + 1
+      return
+    }
+    const p = emnapiTypeTable.data + id
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const tag = emnapiTypeTable.tag(value)
+    $makeSetValue('p', 0, 'tag', 'u8')
+  },
+  erase (start: number, end: number): void {
+    const data = emnapiTypeTable.data
+    end = Math.min(end, emnapiTypeTable.length)
+    if (start < end) {
+      new Uint8Array(wasmMemory.buffer).fill(0, data + start, data + end)
+    }
+  },
+  tag (value: any): number {
+    switch (typeof value) {
+      case 'undefined': return napi_valuetype.napi_undefined + 1
+      case 'boolean': return napi_valuetype.napi_boolean + 1
+      case 'number': return napi_valuetype.napi_number + 1
+      case 'string': return napi_valuetype.napi_string + 1
+      case 'symbol': return napi_valuetype.napi_symbol + 1
+      case 'bigint': return napi_valuetype.napi_bigint + 1
+      case 'function': return napi_valuetype.napi_function + 1
+      case 'object': {
+        if (value === null) return napi_valuetype.napi_null + 1
+        const typedArrayTag = emnapiTypeTable.typedArrayTag
+        if (typedArrayTag === undefined) return 0
+        let flags = emnapiTypeTable.OBJECT
+        try {
+          // sees through proxies without running traps, throws on revoked ones
+          if (Array.isArray(value)) flags |= emnapiTypeTable.ARRAY
+        } catch (_) {
+          return 0
+        }
+        if (typedArrayTag.call(value) !== undefined) flags |= emnapiTypeTable.TYPEDARRAY
+        return flags
+      }
+      default: return 0
+    }
+  },
+  reserve (): void {
+    if (emnapiTypeTable.wantedLength > emnapiTypeTable.length) {
+      emnapiTypeTable.grow(emnapiTypeTable.wantedLength)
+    }
+  },
+  grow (minLength: number): void {
+    const oldData = emnapiTypeTable.data
+    const oldLength = emnapiTypeTable.length
+    let length = Math.max(1024, oldLength)
+    while (length < minLength) length *= 2
+    let data = _malloc($to64('length'))
+    $from64('data')
+    if (!data) abort('emnapiTypeTable: out of memory')
+    const HEAPU8 = new Uint8Array(wasmMemory.buffer)
+    HEAPU8.fill(0, data + oldLength, data + length)
+    if (oldData) {
+      HEAPU8.copyWithin(data, oldData, oldData + oldLength)
+      _free($to64('oldData'))
+    }
+    emnapiTypeTable.data = data
+    emnapiTypeTable.length = length
+    emnapiTypeTable.writeHeader()
+  },
+  writeHeader (): void {
+    const address = emnapiTypeTable.address
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const data = emnapiTypeTable.data
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const length = emnapiTypeTable.length
+    $makeSetValue('address', 0, 'data', '*')
+    $makeSetValue('address', POINTER_SIZE, 'length', 'u32')
+  }
+}
+
+function __emnapi_get_type_table (_env: napi_env): Pointer<unknown> {
+  if (!emnapiTypeTable.address) {
+    // never freed, the table lives as long as the module
+    const size = 2 * $POINTER_SIZE
+    let pointer = _malloc($to64('size'))
+    $from64('pointer')
+    emnapiTypeTable.address = pointer
+    const typedArrayPrototype = Object.getPrototypeOf(Uint8Array.prototype)
+    const desc = typeof Symbol === 'function' ? Object.getOwnPropertyDescriptor(typedArrayPrototype, Symbol.toStringTag) : undefined
+    emnapiTypeTable.typedArrayTag = desc?.get
+    emnapiTypeTable.grow(1)
+    emnapiCtx.handleStore.addTypeRecorder(emnapiTypeTable)
+  } else {
+    emnapiTypeTable.reserve()
+  }
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  const address = emnapiTypeTable.address
+  return $to64('address') as number
+}
+
+emnapiDefineVar('$emnapiTypeTable', emnapiTypeTable, ['malloc', 'free'])
+emnapiImplementInternal('_emnapi_get_type_table', 'pp', __emnapi_get_type_table, ['malloc', '$emnapiTypeTable'])
+emnapiImplementInternal('_emnapi_typeof', 'ippp', napi_typeof)
+emnapiImplementInternal('_emnapi_is_array', 'ippp', napi_is_array)
+emnapiImplementInternal('_emnapi_is_typedarray', 'ippp', napi_is_typedarray)
+
 emnapiImplement('napi_typeof', 'ippp', napi_typeof)
 emnapiImplement('napi_coerce_to_bool', 'ippp', napi_coerce_to_bool)
 emnapiImplement('napi_coerce_to_number', 'ippp', napi_coerce_to_number)
@@ -3,13 +3,13 @@ function napi_get_array_length (env: napi_env, value: napi_value, result: Pointe
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (!handle.isArray()) {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (!Array.isArray(jsValue)) {
     return envObject.setLastError(napi_status.napi_array_expected)
   }
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v = handle.value.length >>> 0
+  const v = jsValue.length >>> 0
   $makeSetValue('result', 0, 'v', 'u32')
   return envObject.clearLastError()
 }
@@ -18,20 +18,20 @@ function napi_get_arraybuffer_info (env: napi_env, arraybuffer: napi_value, data
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, arraybuffer)
-  const handle = emnapiCtx.handleStore.get(arraybuffer)!
-  if (!handle.isArrayBuffer()) {
+  const jsValue = emnapiCtx.handleStore.get(arraybuffer)
+  if (!(jsValue instanceof ArrayBuffer)) {
     return envObject.setLastError(napi_status.napi_invalid_arg)
   }
   if (data) {
     $from64('data')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const p: number = emnapiExternalMemory.getArrayBufferPointer(handle.value, true).address
+    const p: number = emnapiExternalMemory.getArrayBufferPointer(jsValue, true).address
     $makeSetValue('data', 0, 'p', '*')
   }
   if (byte_length) {
     $from64('byte_length')
-    $makeSetValue('byte_length', 0, 'handle.value.byteLength', SIZE_TYPE)
+    $makeSetValue('byte_length', 0, 'jsValue.byteLength', SIZE_TYPE)
   }
   return envObject.clearLastError()
 }
@@ -41,14 +41,14 @@ function napi_get_prototype (env: napi_env, value: napi_value, result: Pointer<n
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (handle.value == null) {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (jsValue == null) {
     envObject.tryCatch.setError(new TypeError('Cannot convert undefined or null to object'))
     return envObject.setLastError(napi_status.napi_pending_exception)
   }
   let v: any
   try {
-    v = handle.isObject() || handle.isFunction() ? handle.value : Object(handle.value)
+    v = emnapiCtx.isReferenceType(jsValue) ? jsValue : Object(jsValue)
   } catch (_) {
     return envObject.setLastError(napi_status.napi_object_expected)
   }
@@ -72,11 +72,11 @@ function _napi_get_typedarray_info (
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, typedarray)
-  const handle = emnapiCtx.handleStore.get(typedarray)!
-  if (!handle.isTypedArray()) {
+  const jsValue = emnapiCtx.handleStore.get(typedarray)
+  if (!emnapiCtx.isTypedArray(jsValue)) {
     return envObject.setLastError(napi_status.napi_invalid_arg)
   }
-  const v: ArrayBufferView = handle.value
+  const v: ArrayBufferView = jsValue
   if (type) {
     $from64('type')
     let t: napi_typedarray_type
@@ -146,8 +146,8 @@ function napi_get_buffer_info (
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, buffer)
-  const handle = emnapiCtx.handleStore.get(buffer)!
-  if (!handle.isBuffer()) {
+  const jsValue = emnapiCtx.handleStore.get(buffer)
+  if (!(typeof emnapiCtx.feature.Buffer === 'function' && emnapiCtx.feature.Buffer.isBuffer(jsValue))) {
     return envObject.setLastError(napi_status.napi_invalid_arg)
   }
   return _napi_get_typedarray_info(env, buffer, 0, length, data, 0, 0)
@@ -164,11 +164,11 @@ function napi_get_dataview_info (
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, dataview)
-  const handle = emnapiCtx.handleStore.get(dataview)!
-  if (!handle.isDataView()) {
+  const jsValue = emnapiCtx.handleStore.get(dataview)
+  if (!(jsValue instanceof DataView)) {
     return envObject.setLastError(napi_status.napi_invalid_arg)
   }
-  const v = handle.value as DataView
+  const v = jsValue as DataView
   if (byte_length) {
     $from64('byte_length')
     $makeSetValue('byte_length', 0, 'v.byteLength', SIZE_TYPE)
@@ -205,12 +205,12 @@ function napi_get_date_value (env: napi_env, value: napi_value, result: Pointer<
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, value)
     $CHECK_ARG!(envObject, result)
-    const handle = emnapiCtx.handleStore.get(value)!
-    if (!handle.isDate()) {
+    const jsValue = emnapiCtx.handleStore.get(value)
+    if (!(jsValue instanceof Date)) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
     $from64('result')
-    v = (handle.value as Date).valueOf()
+    v = (jsValue as Date).valueOf()
     $makeSetValue('result', 0, 'v', 'double')
     return envObject.getReturnStatus()
   })
@@ -221,13 +221,13 @@ function napi_get_value_bool (env: napi_env, value: napi_value, result: Pointer<
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'boolean') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'boolean') {
     return envObject.setLastError(napi_status.napi_boolean_expected)
   }
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = handle.value ? 1 : 0
+  const r = jsValue ? 1 : 0
   $makeSetValue('result', 0, 'r', 'i8')
   return envObject.clearLastError()
 }
@@ -237,13 +237,13 @@ function napi_get_value_double (env: napi_env, value: napi_value, result: Pointe
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'number') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'number') {
     return envObject.setLastError(napi_status.napi_number_expected)
   }
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const r = handle.value
+  const r = jsValue
   $makeSetValue('result', 0, 'r', 'double')
   return envObject.clearLastError()
 }
@@ -257,8 +257,8 @@ function napi_get_value_bigint_int64 (env: napi_env, value: napi_value, result:
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
   $CHECK_ARG!(envObject, lossless)
-  const handle = emnapiCtx.handleStore.get(value)!
-  let numberValue = handle.value
+  const jsValue = emnapiCtx.handleStore.get(value)
+  let numberValue = jsValue
   if (typeof numberValue !== 'bigint') {
     return envObject.setLastError(napi_status.napi_number_expected)
   }
@@ -291,8 +291,8 @@ function napi_get_value_bigint_uint64 (env: napi_env, value: napi_value, result:
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
   $CHECK_ARG!(envObject, lossless)
-  const handle = emnapiCtx.handleStore.get(value)!
-  let numberValue = handle.value
+  const jsValue = emnapiCtx.handleStore.get(value)
+  let numberValue = jsValue
   if (typeof numberValue !== 'bigint') {
     return envObject.setLastError(napi_status.napi_number_expected)
   }
@@ -327,11 +327,11 @@ function napi_get_value_bigint_words (
   }
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, word_count)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (!handle.isBigInt()) {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'bigint') {
     return envObject.setLastError(napi_status.napi_bigint_expected)
   }
-  const isMinus = handle.value < BigInt(0)
+  const isMinus = jsValue < BigInt(0)
 
   $from64('sign_bit')
   $from64('words')
@@ -341,12 +341,12 @@ function napi_get_value_bigint_words (
   $from64('word_count_int')
 
   let wordCount = 0
-  let bigintValue: bigint = isMinus ? (handle.value * BigInt(-1)) : handle.value
+  let bigintValue: bigint = isMinus ? (jsValue * BigInt(-1)) : jsValue
   while (bigintValue !== BigInt(0)) {
     wordCount++
     bigintValue = bigintValue >> BigInt(64)
   }
-  bigintValue = isMinus ? (handle.value * BigInt(-1)) : handle.value
+  bigintValue = isMinus ? (jsValue * BigInt(-1)) : jsValue
   if (!sign_bit && !words) {
     word_count_int = wordCount
     $makeSetValue('word_count', 0, 'word_count_int', SIZE_TYPE)
@@ -379,14 +379,14 @@ function napi_get_value_external (env: napi_env, value: napi_value, result: void
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (!handle.isExternal()) {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (!emnapiCtx.isExternal(jsValue)) {
     return envObject.setLastError(napi_status.napi_invalid_arg)
   }
   $from64('result')
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const p = handle.data(envObject)
+  const p = envObject.getObjectBinding(jsValue).data
   $makeSetValue('result', 0, 'p', '*')
   return envObject.clearLastError()
 }
@@ -396,12 +396,12 @@ function napi_get_value_int32 (env: napi_env, value: napi_value, result: Pointer
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'number') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'number') {
     return envObject.setLastError(napi_status.napi_number_expected)
   }
   $from64('result')
-  $makeSetValue('result', 0, 'handle.value', 'i32')
+  $makeSetValue('result', 0, 'jsValue', 'i32')
   return envObject.clearLastError()
 }
 
@@ -410,11 +410,11 @@ function napi_get_value_int64 (env: napi_env, value: napi_value, result: Pointer
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'number') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'number') {
     return envObject.setLastError(napi_status.napi_number_expected)
   }
-  const numberValue = handle.value
+  const numberValue = jsValue
   $from64('result')
   let tempI64: any
   if (numberValue === Number.POSITIVE_INFINITY || numberValue === Number.NEGATIVE_INFINITY || isNaN(numberValue)) {
@@ -445,24 +445,16 @@ function napi_get_value_string_latin1 (env: napi_env, value: napi_value, buf: ch
   $from64('buf_size')
 
   buf_size = buf_size >>> 0
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'string') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   if (!buf) {
     if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
-    $makeSetValue('result', 0, 'handle.value.length', SIZE_TYPE)
+    $makeSetValue('result', 0, 'jsValue.length', SIZE_TYPE)
   } else if (buf_size !== 0) {
-    let copied: number = 0
-    let v: number
-    for (let i = 0; i < buf_size - 1; ++i) {
-      // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      v = handle.value.charCodeAt(i) & 0xff
-      $makeSetValue('buf', 'i', 'v', 'u8')
-      // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      copied++
-    }
-    $makeSetValue('buf', 'copied', '0', 'u8')
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const copied = emnapiString.stringToLatin1(jsValue, buf, buf_size)
     if (result) {
       $makeSetValue('result', 0, 'copied', SIZE_TYPE)
     }
@@ -481,18 +473,18 @@ function napi_get_value_string_utf8 (env: napi_env, value: napi_value, buf: char
   $from64('buf_size')
 
   buf_size = buf_size >>> 0
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'string') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   if (!buf) {
     if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const strLength = emnapiString.lengthBytesUTF8(handle.value)
+    const strLength = emnapiString.queryLengthUTF8(value, jsValue)
     $makeSetValue('result', 0, 'strLength', SIZE_TYPE)
   } else if (buf_size !== 0) {
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const copied = emnapiString.stringToUTF8(handle.value, buf, buf_size)
+    const copied = emnapiString.copyUTF8(value, jsValue, buf, buf_size)
     if (result) {
       $makeSetValue('result', 0, 'copied', SIZE_TYPE)
     }
@@ -511,16 +503,16 @@ function napi_get_value_string_utf16 (env: napi_env, value: napi_value, buf: cha
   $from64('buf_size')
 
   buf_size = buf_size >>> 0
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'string') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   if (!buf) {
     if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
-    $makeSetValue('result', 0, 'handle.value.length', SIZE_TYPE)
+    $makeSetValue('result', 0, 'jsValue.length', SIZE_TYPE)
   } else if (buf_size !== 0) {
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const copied = emnapiString.stringToUTF16(handle.value, buf, buf_size * 2)
+    const copied = emnapiString.stringToUTF16(jsValue, buf, buf_size * 2)
     if (result) {
       $makeSetValue('result', 0, 'copied / 2', SIZE_TYPE)
     }
@@ -535,12 +527,12 @@ function napi_get_value_uint32 (env: napi_env, value: napi_value, result: Pointe
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const handle = emnapiCtx.handleStore.get(value)!
-  if (typeof handle.value !== 'number') {
+  const jsValue = emnapiCtx.handleStore.get(value)
+  if (typeof jsValue !== 'number') {
     return envObject.setLastError(napi_status.napi_number_expected)
   }
   $from64('result')
-  $makeSetValue('result', 0, 'handle.value', 'u32')
+  $makeSetValue('result', 0, 'jsValue', 'u32')
   return envObject.clearLastError()
 }
 
@@ -552,6 +544,7 @@ emnapiImplement('napi_get_buffer_info', 'ipppp', napi_get_buffer_info, ['napi_ge
 emnapiImplement('napi_get_dataview_info', 'ipppppp', napi_get_dataview_info, ['$emnapiExternalMemory'])
 emnapiImplement('napi_get_date_value', 'ippp', napi_get_date_value)
 emnapiImplement('napi_get_value_bool', 'ippp', napi_get_value_bool)
+emnapiImplementInternal('_emnapi_get_value_bool', 'ippp', napi_get_value_bool)
 emnapiImplement('napi_get_value_double', 'ippp', napi_get_value_double)
 emnapiImplement('napi_get_value_bigint_int64', 'ipppp', napi_get_value_bigint_int64)
 emnapiImplement('napi_get_value_bigint_uint64', 'ipppp', napi_get_value_bigint_uint64)
@@ -559,7 +552,7 @@ emnapiImplement('napi_get_value_bigint_words', 'ippppp', napi_get_value_bigint_w
 emnapiImplement('napi_get_value_external', 'ippp', napi_get_value_external)
 emnapiImplement('napi_get_value_int32', 'ippp', napi_get_value_int32)
 emnapiImplement('napi_get_value_int64', 'ippp', napi_get_value_int64)
-emnapiImplement('napi_get_value_string_latin1', 'ippppp', napi_get_value_string_latin1)
+emnapiImplement('napi_get_value_string_latin1', 'ippppp', napi_get_value_string_latin1, ['$emnapiString'])
 emnapiImplement('napi_get_value_string_utf8', 'ippppp', napi_get_value_string_utf8, ['$emnapiString'])
 
 emnapiImplement('napi_get_value_string_utf16', 'ippppp', napi_get_value_string_utf16, ['$emnapiString'])
@@ -6,7 +6,7 @@ function napi_create_int32 (env: napi_env, value: int32_t, result: Pointer<napi_
   $CHECK_ARG!(envObject, result)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v = emnapiCtx.addToCurrentScope(value).id
+  const v = emnapiCtx.addToCurrentScope(value)
   $makeSetValue('result', 0, 'v', '*')
   return envObject.clearLastError()
 }
@@ -17,7 +17,7 @@ function napi_create_uint32 (env: napi_env, value: uint32_t, result: Pointer<nap
   $CHECK_ARG!(envObject, result)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v = emnapiCtx.addToCurrentScope(value >>> 0).id
+  const v = emnapiCtx.addToCurrentScope(value >>> 0)
   $makeSetValue('result', 0, 'v', '*')
   return envObject.clearLastError()
 }
@@ -32,14 +32,14 @@ function napi_create_int64 (env: napi_env, low: int32_t, high: int32_t, result:
   if (!high) return envObject.setLastError(napi_status.napi_invalid_arg)
   value = Number(low)
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v1 = emnapiCtx.addToCurrentScope(value).id
+  const v1 = emnapiCtx.addToCurrentScope(value)
   $from64('high')
   $makeSetValue('high', 0, 'v1', '*')
 // #else
   if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
   value = (low >>> 0) + (high * Math.pow(2, 32))
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v2 = emnapiCtx.addToCurrentScope(value).id
+  const v2 = emnapiCtx.addToCurrentScope(value)
   $makeSetValue('result', 0, 'v2', '*')
 // #endif
 
@@ -52,32 +52,14 @@ function napi_create_double (env: napi_env, value: double, result: Pointer<napi_
   $CHECK_ARG!(envObject, result)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v = emnapiCtx.addToCurrentScope(value).id
+  const v = emnapiCtx.addToCurrentScope(value)
   $makeSetValue('result', 0, 'v', '*')
   return envObject.clearLastError()
 }
 
 function _napi_create_string_latin1 (env: napi_env, str: const_char_p, length: size_t, result: Pointer<napi_value>): napi_status {
   return emnapiString.newString(env, str, length, result, (autoLength, sizeLength) => {
-    let latin1String = ''
-    let len = 0
-    if (autoLength) {
-      while (true) {
-        const ch = $makeGetValue('str', 0, 'u8') as number
-        if (!ch) break
-        latin1String += String.fromCharCode(ch)
-        str++
-      }
-    } else {
-      while (len < sizeLength) {
-        const ch = $makeGetValue('str', 0, 'u8') as number
-        if (!ch) break
-        latin1String += String.fromCharCode(ch)
-        len++
-        str++
-      }
-    }
-    return latin1String
+    return emnapiString.latin1ToString(str, autoLength ? -1 : sizeLength)
   })
 }
 
@@ -111,7 +93,7 @@ function node_api_create_external_string_latin1 (
     result,
     copied,
     _napi_create_string_latin1,
-    undefined!
+    'latin1'
   )
 }
 
@@ -133,7 +115,7 @@ function node_api_create_external_string_utf16 (
     result,
     copied,
     _napi_create_string_utf16,
-    undefined!
+    'utf16'
   )
 }
 
@@ -150,14 +132,14 @@ function napi_create_bigint_int64 (env: napi_env, low: int32_t, high: int32_t, r
   if (!high) return envObject.setLastError(napi_status.napi_invalid_arg)
   value = low as unknown as BigInt
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v1 = emnapiCtx.addToCurrentScope(value).id
+  const v1 = emnapiCtx.addToCurrentScope(value)
   $from64('high')
   $makeSetValue('high', 0, 'v1', '*')
 // #else
   if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
   value = BigInt(low >>> 0) | (BigInt(high) << BigInt(32))
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v2 = emnapiCtx.addToCurrentScope(value).id
+  const v2 = emnapiCtx.addToCurrentScope(value)
   $makeSetValue('result', 0, 'v2', '*')
 // #endif
 
@@ -177,14 +159,14 @@ function napi_create_bigint_uint64 (env: napi_env, low: int32_t, high: int32_t,
   if (!high) return envObject.setLastError(napi_status.napi_invalid_arg)
   value = low as unknown as BigInt
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v1 = emnapiCtx.addToCurrentScope(value).id
+  const v1 = emnapiCtx.addToCurrentScope(value)
   $from64('high')
   $makeSetValue('high', 0, 'v1', '*')
 // #else
   if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
   value = BigInt(low >>> 0) | (BigInt(high >>> 0) << BigInt(32))
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const v2 = emnapiCtx.addToCurrentScope(value).id
+  const v2 = emnapiCtx.addToCurrentScope(value)
   $makeSetValue('result', 0, 'v2', '*')
 // #endif
 
@@ -218,7 +200,7 @@ function napi_create_bigint_words (env: napi_env, sign_bit: int, word_count: siz
     }
     value *= ((BigInt(sign_bit) % BigInt(2) === BigInt(0)) ? BigInt(1) : BigInt(-1))
     $from64('result')
-    v = emnapiCtx.addToCurrentScope(value).id
+    v = emnapiCtx.addToCurrentScope(value)
     $makeSetValue('result', 0, 'v', '*')
     return envObject.getReturnStatus()
   })
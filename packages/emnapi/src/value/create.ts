@@ -4,7 +4,7 @@ function napi_create_array (env: napi_env, result: Pointer<napi_value>): napi_st
   $CHECK_ARG!(envObject, result)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope([]).id
+  const value = emnapiCtx.addToCurrentScope([])
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -17,7 +17,7 @@ function napi_create_array_with_length (env: napi_env, length: size_t, result: P
   $from64('result')
   length = length >>> 0
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope(new Array(length)).id
+  const value = emnapiCtx.addToCurrentScope(new Array(length))
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -45,7 +45,7 @@ function napi_create_arraybuffer (env: napi_env, byte_length: size_t, data: void
     $CHECK_ARG!(envObject, result)
     $from64('result')
     const arrayBuffer = emnapiCreateArrayBuffer(byte_length, data)
-    value = emnapiCtx.addToCurrentScope(arrayBuffer).id
+    value = emnapiCtx.addToCurrentScope(arrayBuffer)
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -59,7 +59,7 @@ function napi_create_date (env: napi_env, time: double, result: Pointer<napi_val
     $CHECK_ARG!(envObject, result)
     $from64('result')
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = emnapiCtx.addToCurrentScope(new Date(time)).id
+    value = emnapiCtx.addToCurrentScope(new Date(time))
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -74,12 +74,12 @@ function napi_create_external (env: napi_env, data: void_p, finalize_cb: napi_fi
     if (!emnapiCtx.feature.supportFinalizer && finalize_cb) {
       throw emnapiCtx.createNotSupportWeakRefError('napi_create_external', 'Parameter "finalize_cb" must be 0(NULL)')
     }
-    const externalHandle = emnapiCtx.getCurrentScope()!.addExternal(envObject, data)
+    const externalHandle = emnapiCtx.addExternalToCurrentScope(envObject, data)
     if (finalize_cb) {
-      emnapiCtx.createReference(envObject, externalHandle.id, 0, Ownership.kRuntime as any, finalize_cb, data, finalize_hint)
+      emnapiCtx.createReference(envObject, externalHandle, 0, Ownership.kRuntime as any, finalize_cb, data, finalize_hint)
     }
     $from64('result')
-    value = externalHandle.id
+    value = externalHandle
     $makeSetValue('result', 0, 'value', '*')
     return envObject.clearLastError()
   })
@@ -132,7 +132,7 @@ function napi_create_external_arraybuffer (
     }
     const handle = emnapiCtx.addToCurrentScope(arrayBuffer)
     if (finalize_cb) {
-      const status = _napi_add_finalizer(env, handle.id, external_data, finalize_cb, finalize_hint, /* NULL */ 0)
+      const status = _napi_add_finalizer(env, handle, external_data, finalize_cb, finalize_hint, /* NULL */ 0)
       if (status === napi_status.napi_pending_exception) {
         const err = envObject.tryCatch.extractException()
         envObject.clearLastError()
@@ -141,7 +141,7 @@ function napi_create_external_arraybuffer (
         return envObject.setLastError(status)
       }
     }
-    value = handle.id
+    value = handle
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -153,7 +153,7 @@ function napi_create_object (env: napi_env, result: Pointer<napi_value>): napi_s
   $CHECK_ARG!(envObject, result)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope({}).id
+  const value = emnapiCtx.addToCurrentScope({})
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -166,16 +166,15 @@ function napi_create_symbol (env: napi_env, description: napi_value, result: Poi
 
   if (!description) {
     // eslint-disable-next-line symbol-description, @typescript-eslint/no-unused-vars
-    const value = emnapiCtx.addToCurrentScope(Symbol()).id
+    const value = emnapiCtx.addToCurrentScope(Symbol())
     $makeSetValue('result', 0, 'value', '*')
   } else {
-    const handle = emnapiCtx.handleStore.get(description)!
-    const desc = handle.value
+    const desc = emnapiCtx.handleStore.get(description)
     if (typeof desc !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const v = emnapiCtx.addToCurrentScope(Symbol(desc)).id
+    const v = emnapiCtx.addToCurrentScope(Symbol(desc))
     $makeSetValue('result', 0, 'v', '*')
   }
   return envObject.clearLastError()
@@ -196,8 +195,7 @@ function napi_create_typedarray (
     $CHECK_ARG!(envObject, arraybuffer)
     $CHECK_ARG!(envObject, result)
 
-    const handle = emnapiCtx.handleStore.get(arraybuffer)!
-    const buffer = handle.value
+    const buffer = emnapiCtx.handleStore.get(arraybuffer)
     if (!(buffer instanceof ArrayBuffer)) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
@@ -239,7 +237,7 @@ function napi_create_typedarray (
       $from64('result')
 
       // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      value = emnapiCtx.addToCurrentScope(out).id
+      value = emnapiCtx.addToCurrentScope(out)
       $makeSetValue('result', 0, 'value', '*')
       return envObject.getReturnStatus()
     }
@@ -296,7 +294,7 @@ function napi_create_buffer (
     size = size >>> 0
     if (!data || (size === 0)) {
       buffer = Buffer.alloc(size)
-      value = emnapiCtx.addToCurrentScope(buffer).id
+      value = emnapiCtx.addToCurrentScope(buffer)
       $makeSetValue('result', 0, 'value', '*')
     } else {
       pointer = _malloc($to64('size'))
@@ -313,7 +311,7 @@ function napi_create_buffer (
       emnapiExternalMemory.wasmMemoryViewTable.set(buffer, viewDescriptor)
       emnapiExternalMemory.registry?.register(viewDescriptor, pointer)
 
-      value = emnapiCtx.addToCurrentScope(buffer).id
+      value = emnapiCtx.addToCurrentScope(buffer)
       $makeSetValue('result', 0, 'value', '*')
       $from64('data')
       $makeSetValue('data', 0, 'pointer', '*')
@@ -344,7 +342,7 @@ function napi_create_buffer_copy (
     $from64('data')
     $from64('length')
     buffer.set(new Uint8Array(wasmMemory.buffer).subarray(data, data + length))
-    value = emnapiCtx.addToCurrentScope(buffer).id
+    value = emnapiCtx.addToCurrentScope(buffer)
     $from64('result')
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
@@ -387,8 +385,7 @@ function napi_create_dataview (
     $from64('byte_offset')
     byte_length = byte_length >>> 0
     byte_offset = byte_offset >>> 0
-    const handle = emnapiCtx.handleStore.get(arraybuffer)!
-    const buffer = handle.value
+    const buffer = emnapiCtx.handleStore.get(arraybuffer)
     if (!(buffer instanceof ArrayBuffer)) {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
@@ -414,7 +411,7 @@ function napi_create_dataview (
     $from64('result')
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = emnapiCtx.addToCurrentScope(dataview).id
+    value = emnapiCtx.addToCurrentScope(dataview)
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -441,7 +438,7 @@ function node_api_symbol_for (env: napi_env, utf8description: const_char_p, leng
   const descriptionString = emnapiString.UTF8ToString(utf8description, length)
 
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const value = emnapiCtx.addToCurrentScope(Symbol.for(descriptionString)).id
+  const value = emnapiCtx.addToCurrentScope(Symbol.for(descriptionString))
   $makeSetValue('result', 0, 'value', '*')
   return envObject.clearLastError()
 }
@@ -51,22 +51,22 @@ function napi_define_class (
         if (!name) {
           return envObject.setLastError(napi_status.napi_name_expected)
         }
-        propertyName = emnapiCtx.handleStore.get(name)!.value
+        propertyName = emnapiCtx.handleStore.get(name)
         if (typeof propertyName !== 'string' && typeof propertyName !== 'symbol') {
           return envObject.setLastError(napi_status.napi_name_expected)
         }
       }
 
-      if ((attributes & napi_property_attributes.napi_static) !== 0) {
-        emnapiDefineProperty(envObject, F, propertyName, method, getter, setter, value, attributes, data)
+      const target = (attributes & napi_property_attributes.napi_static) !== 0 ? F : F.prototype
+      if (method && !getter && !setter && (attributes & napi_property_attributes.napi_configurable) !== 0) {
+        emnapiDefineLazyMethod(envObject, target, propertyName, method, attributes, data)
         continue
       }
-      emnapiDefineProperty(envObject, F.prototype, propertyName, method, getter, setter, value, attributes, data)
+      emnapiDefineProperty(envObject, target, propertyName, method, getter, setter, value, attributes, data)
     }
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const valueHandle = emnapiCtx.addToCurrentScope(F)
-    valueHandleId = valueHandle.id
+    valueHandleId = emnapiCtx.addToCurrentScope(F)
     $from64('result')
     $makeSetValue('result', 0, 'valueHandleId', '*')
     return envObject.getReturnStatus()
@@ -90,15 +90,15 @@ function napi_type_tag_object (env: napi_env, object: napi_value, type_tag: Cons
     if (!object) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_invalid_arg)
     }
-    const value = emnapiCtx.handleStore.get(object)!
-    if (!(value.isObject() || value.isFunction())) {
+    const jsValue = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsValue)) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_object_expected)
     }
     $from64('type_tag')
     if (!type_tag) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_invalid_arg)
     }
-    const binding = envObject.getObjectBinding(value.value)
+    const binding = envObject.getObjectBinding(jsValue)
     if (binding.tag !== null) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_invalid_arg)
     }
@@ -121,8 +121,8 @@ function napi_check_object_type_tag (env: napi_env, object: napi_value, type_tag
     if (!object) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_invalid_arg)
     }
-    const value = emnapiCtx.handleStore.get(object)!
-    if (!(value.isObject() || value.isFunction())) {
+    const jsValue = emnapiCtx.handleStore.get(object)
+    if (!emnapiCtx.isReferenceType(jsValue)) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_object_expected)
     }
     if (!type_tag) {
@@ -131,7 +131,7 @@ function napi_check_object_type_tag (env: napi_env, object: napi_value, type_tag
     if (!result) {
       return envObject.setLastError(envObject.tryCatch.hasCaught() ? napi_status.napi_pending_exception : napi_status.napi_invalid_arg)
     }
-    const binding = envObject.getObjectBinding(value.value)
+    const binding = envObject.getObjectBinding(jsValue)
     if (binding.tag !== null) {
       $from64('type_tag')
       for (i = 0; i < 4; i++) {
@@ -174,7 +174,7 @@ function _napi_add_finalizer (env: napi_env, js_object: napi_value, finalize_dat
   $from64('finalize_data')
   $from64('finalize_cb')
   $from64('finalize_hint')
-  const reference = emnapiCtx.createReference(envObject, handle.id, 0, ownership as any, finalize_cb, finalize_data, finalize_hint)
+  const reference = emnapiCtx.createReference(envObject, handle, 0, ownership as any, finalize_cb, finalize_data, finalize_hint)
   if (result) {
     $from64('result')
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
@@ -185,7 +185,7 @@ function _napi_add_finalizer (env: napi_env, js_object: napi_value, finalize_dat
   return envObject.clearLastError()
 }
 
-emnapiImplement('napi_define_class', 'ipppppppp', napi_define_class, ['$emnapiCreateFunction', '$emnapiDefineProperty', '$emnapiString'])
+emnapiImplement('napi_define_class', 'ipppppppp', napi_define_class, ['$emnapiCreateFunction', '$emnapiDefineProperty', '$emnapiDefineLazyMethod', '$emnapiString'])
 emnapiImplement('napi_wrap', 'ipppppp', napi_wrap, ['$emnapiWrap'])
 emnapiImplement('napi_unwrap', 'ippp', napi_unwrap, ['$emnapiUnwrap'])
 emnapiImplement('napi_remove_wrap', 'ippp', napi_remove_wrap, ['$emnapiUnwrap'])
@@ -15,6 +15,8 @@ import type {
   FunctionDeclaration,
   FunctionExpression,
   MethodDeclaration,
+  GetAccessorDeclaration,
+  SetAccessorDeclaration,
   Statement
 } from 'typescript'
 
@@ -94,6 +96,91 @@ function getDataViewSetMethod (defines: Record<string, any>, type: Type): string
   }
 }
 
+function getHeapView (defines: Record<string, any>, type: Type): [string, number] | undefined {
+  if (defines.MEMORY64) {
+    switch (type) {
+      case 'i8': return ['HEAP8', 0]
+      case 'u8': return ['HEAPU8', 0]
+      default: return undefined
+    }
+  }
+  switch (type) {
+    case 'i8': return ['HEAP8', 0]
+    case 'u8': return ['HEAPU8', 0]
+    case 'i16': return ['HEAP16', 1]
+    case 'u16': return ['HEAPU16', 1]
+    case 'i32': return ['HEAP32', 2]
+    case 'u32': return ['HEAPU32', 2]
+    case 'float': return ['HEAPF32', 2]
+    case 'double': return ['HEAPF64', 3]
+    case '*': return ['HEAP32', 2]
+    default: return undefined
+  }
+}
+
+type FunctionLike = FunctionDeclaration | FunctionExpression | MethodDeclaration | GetAccessorDeclaration | SetAccessorDeclaration
+
+function isAssigned (node: Node, name: string): boolean {
+  if (ts.isBinaryExpression(node) &&
+      node.operatorToken.kind >= ts.SyntaxKind.FirstAssignment &&
+      node.operatorToken.kind <= ts.SyntaxKind.LastAssignment &&
+      ts.isIdentifier(node.left) && node.left.text === name) {
+    return true
+  }
+  if ((ts.isPrefixUnaryExpression(node) || ts.isPostfixUnaryExpression(node)) &&
+      (node.operator === ts.SyntaxKind.PlusPlusToken || node.operator === ts.SyntaxKind.MinusMinusToken) &&
+      ts.isIdentifier(node.operand) && node.operand.text === name) {
+    return true
+  }
+  return ts.forEachChild(node, (child) => isAssigned(child, name) ? true : undefined) ?? false
+}
+
+/**
+ * Parameters typed as a pointer to a sized C type, which the C ABI aligns
+ * to that type. void_p and char_p may point anywhere, and a parameter the
+ * body reassigns is no longer known to be the pointer it was passed.
+ */
+function getAlignedPointerParameters (fn: FunctionLike): Set<string> {
+  const names = new Set<string>()
+  for (const param of fn.parameters) {
+    if (!ts.isIdentifier(param.name) || !param.type || !ts.isTypeReferenceNode(param.type)) continue
+    let type = param.type
+    // Const<Pointer<T>>
+    const inner = type.typeArguments?.[0]
+    if (ts.isIdentifier(type.typeName) && type.typeName.text === 'Const' && inner && ts.isTypeReferenceNode(inner)) {
+      type = inner
+    }
+    const typeName = type.typeName
+    if (!ts.isIdentifier(typeName)) continue
+    if (typeName.text !== 'Pointer' && typeName.text !== 'PointerPointer' && !typeName.text.endsWith('_pp')) continue
+    if (fn.body && isAssigned(fn.body, param.name.text)) continue
+    names.add(param.name.text)
+  }
+  return names
+}
+
+/** whether the byte offset is known to be a multiple of `size` */
+function isAlignedOffset (defines: Record<string, any>, param: Expression, size: number): boolean {
+  const pointerSize = defines.MEMORY64 ? 8 : 4
+  if (ts.isNumericLiteral(param) || ts.isStringLiteral(param)) {
+    return /^\d+$/.test(param.text) && Number(param.text) % size === 0
+  }
+  if (ts.isIdentifier(param)) {
+    return param.text === 'POINTER_SIZE' && pointerSize % size === 0
+  }
+  if (ts.isBinaryExpression(param)) {
+    // 'i * ' + POINTER_SIZE
+    if (param.operatorToken.kind === ts.SyntaxKind.PlusToken) {
+      return ts.isStringLiteral(param.left) && /^\w+ \* $/.test(param.left.text) && pointerSize % size === 0
+    }
+    // POINTER_SIZE * 2
+    if (param.operatorToken.kind === ts.SyntaxKind.AsteriskToken) {
+      return ts.isNumericLiteral(param.right) && (pointerSize * Number(param.right.text)) % size === 0
+    }
+  }
+  return false
+}
+
 function byteOffsetParameter (factory: NodeFactory, defines: Record<string, any>, param: Expression): NumericLiteral | Expression {
   if (ts.isNumericLiteral(param) || ts.isStringLiteral(param)) {
     return factory.createNumericLiteral(param.text)
@@ -127,52 +214,55 @@ function byteOffsetParameter (factory: NodeFactory, defines: Record<string, any>
 
 class Transform {
   ctx: TransformationContext
-  functionDeclarations: Array<FunctionDeclaration | FunctionExpression | MethodDeclaration>
-  injectDataViewDecl: boolean
+  functionDeclarations: FunctionLike[]
+  alignedPointers: Array<Set<string>>
+  injectMemoryViewsCheck: boolean
   defines: Record<string, any>
 
   constructor (context: TransformationContext, defines: Record<string, any>) {
     this.ctx = context
     this.functionDeclarations = []
-    this.injectDataViewDecl = false
+    this.alignedPointers = []
+    this.injectMemoryViewsCheck = false
     this.defines = defines
     this.visitor = this.visitor.bind(this)
   }
 
   visitor (node: Node): VisitResult<Node | undefined> {
-    if (ts.isFunctionDeclaration(node) || ts.isFunctionExpression(node) || ts.isMethodDeclaration(node)) {
+    // accessors, including those of object literals, run after the enclosing function returns
+    if (ts.isFunctionDeclaration(node) || ts.isFunctionExpression(node) || ts.isMethodDeclaration(node) ||
+        ts.isGetAccessorDeclaration(node) || ts.isSetAccessorDeclaration(node)) {
+      const outerInjectMemoryViewsCheck = this.injectMemoryViewsCheck
+      this.injectMemoryViewsCheck = false
       this.functionDeclarations.push(node)
+      this.alignedPointers.push(getAlignedPointerParameters(node))
       const result = ts.visitEachChild(node, this.visitor, this.ctx)
+      this.alignedPointers.pop()
       this.functionDeclarations.pop()
       const statements = result.body?.statements ?? []
-      if (this.injectDataViewDecl && this.functionDeclarations.length === 0) {
-        this.injectDataViewDecl = false
-        const decl = this.ctx.factory.createVariableStatement(
-          undefined,
-          this.ctx.factory.createVariableDeclarationList(
-            [this.ctx.factory.createVariableDeclaration(
+      const injectMemoryViewsCheck = this.injectMemoryViewsCheck
+      this.injectMemoryViewsCheck = outerInjectMemoryViewsCheck
+      // nested functions may be called after memory grows, so each one checks on its own
+      if (injectMemoryViewsCheck && result.body) {
+        // module level views are recreated only after memory grows
+        const decl = this.ctx.factory.createIfStatement(
+          this.ctx.factory.createBinaryExpression(
+            this.ctx.factory.createPropertyAccessExpression(
               this.ctx.factory.createIdentifier('HEAP_DATA_VIEW'),
-              undefined,
-              undefined,
-              this.ctx.factory.createNewExpression(
-                this.ctx.factory.createIdentifier('DataView'),
-                undefined,
-                [this.ctx.factory.createPropertyAccessExpression(
-                  this.ctx.factory.createIdentifier('wasmMemory'),
-                  this.ctx.factory.createIdentifier('buffer')
-                )]
-              )
-            )],
-            ts.NodeFlags.None
-          )
+              this.ctx.factory.createIdentifier('buffer')
+            ),
+            this.ctx.factory.createToken(ts.SyntaxKind.ExclamationEqualsEqualsToken),
+            this.ctx.factory.createPropertyAccessExpression(
+              this.ctx.factory.createIdentifier('wasmMemory'),
+              this.ctx.factory.createIdentifier('buffer')
+            )
+          ),
+          this.ctx.factory.createExpressionStatement(this.ctx.factory.createCallExpression(
+            this.ctx.factory.createIdentifier('updateMemoryViews'),
+            undefined,
+            []
+          ))
         )
-        const modifiers = ts.getModifiers(result)!
-        const asteriskToken = result.asteriskToken
-        const name = result.name!
-        const questionToken = result.questionToken
-        const typeParameters = result.typeParameters
-        const parameters = result.parameters
-        const type = result.type
         const body = this.ctx.factory.createBlock(
           this.ctx.factory.createNodeArray([
             decl,
@@ -180,6 +270,35 @@ class Transform {
           ]),
           true
         )
+        if (ts.isGetAccessorDeclaration(node)) {
+          const accessor = result as GetAccessorDeclaration
+          return this.ctx.factory.updateGetAccessorDeclaration(
+            accessor,
+            ts.getModifiers(accessor),
+            accessor.name,
+            accessor.parameters,
+            accessor.type,
+            body
+          )
+        }
+        if (ts.isSetAccessorDeclaration(node)) {
+          const accessor = result as SetAccessorDeclaration
+          return this.ctx.factory.updateSetAccessorDeclaration(
+            accessor,
+            ts.getModifiers(accessor),
+            accessor.name,
+            accessor.parameters,
+            body
+          )
+        }
+        const fn = result as FunctionDeclaration | FunctionExpression | MethodDeclaration
+        const modifiers = ts.getModifiers(fn)!
+        const asteriskToken = fn.asteriskToken
+        const name = fn.name!
+        const questionToken = (fn as MethodDeclaration).questionToken
+        const typeParameters = fn.typeParameters
+        const parameters = fn.parameters
+        const type = fn.type
         if (ts.isMethodDeclaration(node)) {
           return this.ctx.factory.updateMethodDeclaration(
             result as MethodDeclaration,
@@ -322,7 +441,12 @@ class Transform {
       }
     }
 
-    this.injectDataViewDecl = true
+    this.injectMemoryViewsCheck = true
+    const address = this.addressExpression(argv0, argv1)
+    const heapView = this.getAlignedHeapView(type, argv0, argv1)
+    if (heapView) {
+      return this.heapElementAccess(heapView, address)
+    }
     return this.ctx.factory.createCallExpression(
       this.ctx.factory.createPropertyAccessExpression(
         this.ctx.factory.createIdentifier('HEAP_DATA_VIEW'),
@@ -330,18 +454,45 @@ class Transform {
       ),
       undefined,
       [
-        ((ts.isNumericLiteral(argv1) || ts.isStringLiteral(argv1)) && argv1.text === '0')
-          ? this.ctx.factory.createNumericLiteral(argv0.text)
-          : (this.ctx.factory.createBinaryExpression(
-              this.ctx.factory.createNumericLiteral(argv0.text),
-              this.ctx.factory.createToken(ts.SyntaxKind.PlusToken),
-              byteOffsetParameter(this.ctx.factory, this.defines, argv1)
-            )),
+        address,
         this.ctx.factory.createTrue()
       ]
     )
   }
 
+  addressExpression (pointer: StringLiteral, offset: Expression): Expression {
+    return ((ts.isNumericLiteral(offset) || ts.isStringLiteral(offset)) && offset.text === '0')
+      ? this.ctx.factory.createNumericLiteral(pointer.text)
+      : (this.ctx.factory.createBinaryExpression(
+          this.ctx.factory.createNumericLiteral(pointer.text),
+          this.ctx.factory.createToken(ts.SyntaxKind.PlusToken),
+          byteOffsetParameter(this.ctx.factory, this.defines, offset)
+        ))
+  }
+
+  // typed array indexing truncates unaligned addresses, the DataView does not
+  getAlignedHeapView (type: Type, pointer: StringLiteral, offset: Expression): [string, number] | undefined {
+    const heapView = getHeapView(this.defines, type)
+    if (!heapView || heapView[1] === 0) return heapView
+    const aligned = this.alignedPointers[this.alignedPointers.length - 1]
+    if (aligned === undefined || !aligned.has(pointer.text)) return undefined
+    return isAlignedOffset(this.defines, offset, 1 << heapView[1]) ? heapView : undefined
+  }
+
+  heapElementAccess ([heap, shift]: [string, number], address: Expression): Expression {
+    const factory = this.ctx.factory
+    return factory.createElementAccessExpression(
+      factory.createIdentifier(heap),
+      shift === 0
+        ? address
+        : factory.createBinaryExpression(
+          factory.createParenthesizedExpression(address),
+          factory.createToken(ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken),
+          factory.createNumericLiteral(shift)
+        )
+    )
+  }
+
   expandMakeSetValue (node: CallExpression): Expression {
     const callexp = node
     const argv0 = callexp.arguments[0]
@@ -369,7 +520,16 @@ class Transform {
       }
     }
 
-    this.injectDataViewDecl = true
+    this.injectMemoryViewsCheck = true
+    const address = this.addressExpression(argv0, argv1)
+    const heapView = this.getAlignedHeapView(type, argv0, argv1)
+    if (heapView) {
+      return this.ctx.factory.createParenthesizedExpression(this.ctx.factory.createBinaryExpression(
+        this.heapElementAccess(heapView, address),
+        this.ctx.factory.createToken(ts.SyntaxKind.EqualsToken),
+        this.ctx.factory.createNumericLiteral(argv2.text)
+      ))
+    }
     const methodName = getDataViewSetMethod(this.defines, type)
     return this.ctx.factory.createCallExpression(
       this.ctx.factory.createPropertyAccessExpression(
@@ -378,13 +538,7 @@ class Transform {
       ),
       undefined,
       [
-        ((ts.isNumericLiteral(argv1) || ts.isStringLiteral(argv1)) && argv1.text === '0')
-          ? this.ctx.factory.createNumericLiteral(argv0.text)
-          : (this.ctx.factory.createBinaryExpression(
-              this.ctx.factory.createNumericLiteral(argv0.text),
-              this.ctx.factory.createToken(ts.SyntaxKind.PlusToken),
-              byteOffsetParameter(this.ctx.factory, this.defines, argv1)
-            )),
+        address,
         methodName === 'setBigInt64' || methodName === 'setBigUint64'
           ? (this.ctx.factory.createCallExpression(
               this.ctx.factory.createIdentifier('BigInt'),
@@ -52,6 +52,135 @@ function isMacroCall (node: Node): node is CallExpression {
     node.expression.expression.text.charAt(0) === '$'
 }
 
+// callees that can neither run user JS nor throw,
+// handle creation is only safe because type recorders must not do either (see TypeRecorder)
+const leanCallees = [
+  'emnapiCtx.handleStore.get',
+  'emnapiCtx.addToCurrentScope',
+  'emnapiCtx.ensureHandle'
+]
+
+const leanEnvMethods = [
+  'setLastError',
+  'clearLastError',
+  'getReturnStatus',
+  'ensureHandle',
+  'ensureHandleId'
+]
+
+const leanBinaryOperators = [
+  ts.SyntaxKind.EqualsEqualsEqualsToken,
+  ts.SyntaxKind.ExclamationEqualsEqualsToken,
+  ts.SyntaxKind.AmpersandAmpersandToken,
+  ts.SyntaxKind.BarBarToken
+]
+
+// for each compile time macro, which arguments are expressions
+// that end up in the emitted code, the rest are type names
+const leanMacroExprArgs: Record<string, number[]> = {
+  $makeSetValue: [0, 1, 2],
+  $makeGetValue: [0, 1],
+  $from64: [0],
+  $to64: [0]
+}
+
+function isLeanMacroArg (arg: ts.Expression, envName: string): boolean {
+  if (ts.isNumericLiteral(arg)) return true
+  if (ts.isStringLiteral(arg)) {
+    const source = ts.createSourceFile('macro-arg.ts', `(${arg.text})`, ts.ScriptTarget.Latest, false, ts.ScriptKind.TS)
+    return source.statements.length === 1 && isLeanBody(source.statements[0], envName)
+  }
+  return isLeanBody(arg, envName)
+}
+
+function getQualifiedName (node: ts.Expression): string {
+  if (ts.isIdentifier(node)) return node.text
+  if (ts.isPropertyAccessExpression(node) && ts.isIdentifier(node.name)) {
+    const left = getQualifiedName(node.expression)
+    return left ? `${left}.${node.name.text}` : ''
+  }
+  return ''
+}
+
+function isConstEnumName (name: string): boolean {
+  return /^(napi_|node_api_|emnapi_)/.test(name) || name === 'Version'
+}
+
+/**
+ * Conservative check that the body of `$PREAMBLE!` cannot call into user JS
+ * or throw, in which case the try/catch is not emitted.
+ * Anything not recognized here keeps the full preamble.
+ */
+function isLeanBody (node: Node, envName: string): boolean {
+  if (ts.isTypeNode(node)) return true
+  switch (node.kind) {
+    case ts.SyntaxKind.Block:
+    case ts.SyntaxKind.VariableStatement:
+    case ts.SyntaxKind.VariableDeclarationList:
+    case ts.SyntaxKind.ExpressionStatement:
+    case ts.SyntaxKind.ReturnStatement:
+    case ts.SyntaxKind.IfStatement:
+    case ts.SyntaxKind.ParenthesizedExpression:
+    case ts.SyntaxKind.NonNullExpression:
+    case ts.SyntaxKind.AsExpression:
+    case ts.SyntaxKind.ConditionalExpression:
+    case ts.SyntaxKind.TypeOfExpression:
+    case ts.SyntaxKind.QuestionToken:
+    case ts.SyntaxKind.ColonToken:
+    case ts.SyntaxKind.Identifier:
+    case ts.SyntaxKind.NumericLiteral:
+    case ts.SyntaxKind.StringLiteral:
+    case ts.SyntaxKind.TrueKeyword:
+    case ts.SyntaxKind.FalseKeyword:
+    case ts.SyntaxKind.NullKeyword:
+      return !ts.forEachChild(node, (child) => isLeanBody(child, envName) ? undefined : true)
+    case ts.SyntaxKind.VariableDeclaration: {
+      const decl = node as ts.VariableDeclaration
+      return ts.isIdentifier(decl.name) && (decl.initializer === undefined || isLeanBody(decl.initializer, envName))
+    }
+    case ts.SyntaxKind.PrefixUnaryExpression: {
+      const expr = node as ts.PrefixUnaryExpression
+      return expr.operator === ts.SyntaxKind.ExclamationToken && isLeanBody(expr.operand, envName)
+    }
+    case ts.SyntaxKind.BinaryExpression: {
+      const expr = node as ts.BinaryExpression
+      if (expr.operatorToken.kind === ts.SyntaxKind.EqualsToken) {
+        return ts.isIdentifier(expr.left) && isLeanBody(expr.right, envName)
+      }
+      return leanBinaryOperators.includes(expr.operatorToken.kind) &&
+        isLeanBody(expr.left, envName) && isLeanBody(expr.right, envName)
+    }
+    case ts.SyntaxKind.PropertyAccessExpression: {
+      const expr = node as ts.PropertyAccessExpression
+      return ts.isIdentifier(expr.expression) && isConstEnumName(expr.expression.text)
+    }
+    case ts.SyntaxKind.CallExpression: {
+      const expr = node as CallExpression
+      const callee = ts.isNonNullExpression(expr.expression) ? expr.expression.expression : expr.expression
+      const name = getQualifiedName(callee)
+      if (!name) return false
+      if (name === '$CHECK_ENV' || name === '$CHECK_ARG') {
+        // expanded to `if (!x) return ...setLastError(...)` by this transformer
+        return expr.arguments.every((arg) => ts.isIdentifier(arg))
+      }
+      if (name.charAt(0) === '$') {
+        // compile time macros, their string arguments are pasted into the emitted code
+        const exprArgs = leanMacroExprArgs[name]
+        if (!exprArgs) return false
+        return expr.arguments.every((arg, i) => exprArgs.includes(i)
+          ? isLeanMacroArg(arg, envName)
+          : ts.isStringLiteral(arg))
+      }
+      if (!leanCallees.includes(name) && !(leanEnvMethods.some((m) => name === `${envName}.${m}`))) {
+        return false
+      }
+      return expr.arguments.every((arg) => isLeanBody(arg, envName))
+    }
+    default:
+      return false
+  }
+}
+
 class Transform {
   ctx: TransformationContext
 
@@ -98,6 +227,7 @@ class Transform {
     if (!ts.isIdentifier(args[0])) throw new Error('$PREAMBLE!() the first argument is not identifier')
     if (!ts.isArrowFunction(args[1])) throw new Error('$PREAMBLE!() the second argument is not arrow function')
     const param0 = args[1].parameters[0]?.name.getText() ?? 'envObject'
+    const lean = isLeanBody(args[1].body, param0)
 
     return [
       factory.createIfStatement(
@@ -200,47 +330,52 @@ class Transform {
         undefined,
         []
       )),
-      factory.createTryStatement(
-        factory.createBlock(
+      lean
+        ? factory.createBlock(
           [...ts.visitEachChild(args[1].body as ts.Block, this.visitor, this.ctx).statements],
           true
-        ),
-        factory.createCatchClause(
-          factory.createVariableDeclaration(
-            factory.createIdentifier('err'),
-            undefined,
-            undefined,
-            undefined
-          ),
+        )
+        : factory.createTryStatement(
           factory.createBlock(
-            [
-              factory.createExpressionStatement(factory.createCallExpression(
-                factory.createPropertyAccessExpression(
+            [...ts.visitEachChild(args[1].body as ts.Block, this.visitor, this.ctx).statements],
+            true
+          ),
+          factory.createCatchClause(
+            factory.createVariableDeclaration(
+              factory.createIdentifier('err'),
+              undefined,
+              undefined,
+              undefined
+            ),
+            factory.createBlock(
+              [
+                factory.createExpressionStatement(factory.createCallExpression(
+                  factory.createPropertyAccessExpression(
+                    factory.createPropertyAccessExpression(
+                      factory.createIdentifier(param0),
+                      factory.createIdentifier('tryCatch')
+                    ),
+                    factory.createIdentifier('setError')
+                  ),
+                  undefined,
+                  [factory.createIdentifier('err')]
+                )),
+                factory.createReturnStatement(factory.createCallExpression(
                   factory.createPropertyAccessExpression(
                     factory.createIdentifier(param0),
-                    factory.createIdentifier('tryCatch')
+                    factory.createIdentifier('setLastError')
                   ),
-                  factory.createIdentifier('setError')
-                ),
-                undefined,
-                [factory.createIdentifier('err')]
-              )),
-              factory.createReturnStatement(factory.createCallExpression(
-                factory.createPropertyAccessExpression(
-                  factory.createIdentifier(param0),
-                  factory.createIdentifier('setLastError')
-                ),
-                undefined,
-                [
-                  ts.addSyntheticTrailingComment(factory.createNumericLiteral(String(napi_status.napi_pending_exception)), ts.SyntaxKind.MultiLineCommentTrivia, ' napi_status.napi_pending_exception ')
-                ]
-              ))
-            ],
-            true
-          )
-        ),
-        undefined
-      )
+                  undefined,
+                  [
+                    ts.addSyntheticTrailingComment(factory.createNumericLiteral(String(napi_status.napi_pending_exception)), ts.SyntaxKind.MultiLineCommentTrivia, ' napi_status.napi_pending_exception ')
+                  ]
+                ))
+              ],
+              true
+            )
+          ),
+          undefined
+        )
     ]
   }
 
@@ -5,7 +5,9 @@ export class CallbackInfo {
     public parent: CallbackInfo | null,
     public thiz: any,
     public data: void_p,
-    public args: ArrayLike<any>,
+    public thisHandle: napi_value,
+    public argsStart: napi_value,
+    public argc: number,
     public fn: Function
   ) {}
 
@@ -19,24 +21,48 @@ export class CallbackInfo {
 export class CallbackInfoStack {
   public current: CallbackInfo | null = null
 
+  // frames are reused across calls, frames[i].parent is always frames[i - 1]
+  private readonly _frames: CallbackInfo[] = []
+  private _depth: number = 0
+
   public pop (): void {
     const current = this.current
     if (current === null) return
+    this._depth--
+    current.thiz = undefined
+    current.fn = undefined!
     this.current = current.parent
   }
 
+  // `this` and the arguments have been added to the current scope from thisHandle
   public push (
     thiz: any,
     data: void_p,
-    args: ArrayLike<any>,
+    thisHandle: napi_value,
+    argc: number,
     fn: Function
   ): CallbackInfo {
-    const info = new CallbackInfo(this.current, thiz, data, args, fn)
+    const depth = this._depth
+    let info = this._frames[depth]
+    if (info === undefined) {
+      info = new CallbackInfo(this.current, thiz, data, thisHandle, thisHandle + 1, argc, fn)
+      this._frames[depth] = info
+    } else {
+      info.thiz = thiz
+      info.data = data
+      info.thisHandle = thisHandle
+      info.argsStart = thisHandle + 1
+      info.argc = argc
+      info.fn = fn
+    }
+    this._depth = depth + 1
     this.current = info
     return info
   }
 
   public dispose (): void {
     this.current = null
+    this._frames.length = 0
+    this._depth = 0
   }
 }
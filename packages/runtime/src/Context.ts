@@ -1,10 +1,11 @@
 import { ScopeStore } from './ScopeStore'
-import { HandleStore } from './Handle'
-import type { Handle } from './Handle'
-import type { HandleScope } from './HandleScope'
+import { HandleStore, type HandleStoreOptions } from './Handle'
 import { Env, newEnv } from './env'
 import {
   _global,
+  isReferenceType,
+  isExternal,
+  isTypedArray,
   supportReflect,
   supportFinalizer,
   supportWeakSymbol,
@@ -22,8 +23,10 @@ import {
 import { CallbackInfoStack } from './CallbackInfo'
 import { NotSupportWeakRefError, NotSupportBufferError } from './errors'
 import { Reference } from './Reference'
+import { RefBase } from './RefBase'
 import { type IDeferrdValue, Deferred } from './Deferred'
 import { Store } from './Store'
+import { RefTracker } from './RefTracker'
 
 export type CleanupHookCallbackFunction = number | ((arg: number) => void)
 
@@ -106,16 +109,73 @@ class NodejsWaitingRequestCounter {
   }
 }
 
+// most deployments load one addon per context,
+// the slot lookup is skipped while only one env is alive
+class EnvStore extends Store<Env> {
+  private _single: Env | undefined = undefined
+
+  public override add (value: Env): void {
+    super.add(value)
+    this._updateSingle()
+  }
+
+  public override get (id: Ptr): Env | undefined {
+    const single = this._single
+    if (single !== undefined && single.id === id) return single
+    return super.get(id)
+  }
+
+  public override remove (id: Ptr): void {
+    super.remove(id)
+    this._updateSingle()
+  }
+
+  public override dispose (): void {
+    super.dispose()
+    this._single = undefined
+  }
+
+  private _updateSingle (): void {
+    let single: Env | undefined
+    if (this.count === 1) {
+      this.forEach((envObject) => { single = envObject })
+    }
+    this._single = single
+  }
+}
+
+export interface ContextOptions {
+  handleStore?: HandleStoreOptions
+  /** hand out small integers as tagged napi_value, wasm32 only, see EMNAPI_TAGGED_VALUES */
+  taggedValues?: boolean
+}
+
+export interface RuntimeStats {
+  handleCount: number
+  peakHandleCount: number
+  persistentHandleCount: number
+  scopeDepth: number
+  peakScopeDepth: number
+  referenceCount: number
+  deferredCount: number
+  finalizerCount: number
+  pendingFinalizerCount: number
+  handleCapacity: number
+}
+
 export class Context {
   private _isStopping = false
   private _canCallIntoJs = true
+  // _canCallIntoJs && !_isStopping, checked on every call
+  private _jsCallable = true
 
-  public envStore = new Store<Env>()
-  public scopeStore = new ScopeStore()
+  public envStore = new EnvStore()
+  public handleStore: HandleStore
+  public scopeStore: ScopeStore
   public refStore = new Store<Reference>()
   public deferredStore = new Store<Deferred>()
-  public handleStore = new HandleStore()
-  public cbinfoStack = new CallbackInfoStack()
+  public cbinfoStack: CallbackInfoStack
+  public readonly taggedValues: boolean
   private readonly refCounter?: NodejsWaitingRequestCounter
   private readonly cleanupQueue: CleanupQueue
 
@@ -131,7 +191,11 @@ export class Context {
     MessageChannel: _MessageChannel
   }
 
-  public constructor () {
+  public constructor (options: ContextOptions = {}) {
+    this.handleStore = new HandleStore(options.handleStore)
+    this.taggedValues = Boolean(options.taggedValues)
+    this.scopeStore = new ScopeStore(this.handleStore)
+    this.cbinfoStack = new CallbackInfoStack()
     this.cleanupQueue = new CleanupQueue()
     if (typeof process === 'object' && process !== null && typeof process.once === 'function') {
       this.refCounter = new NodejsWaitingRequestCounter()
@@ -151,6 +215,18 @@ export class Context {
     }
   }
 
+  isReferenceType (v: any): v is object {
+    return isReferenceType(v)
+  }
+
+  isExternal (v: any): boolean {
+    return isExternal(v)
+  }
+
+  isTypedArray (v: any): v is ArrayBufferView {
+    return isTypedArray(v)
+  }
+
   createNotSupportWeakRefError (api: string, message: string): NotSupportWeakRefError {
     return new NotSupportWeakRefError(api, message)
   }
@@ -179,6 +255,16 @@ export class Context {
     )
   }
 
+  /** runtime-owned finalizer tracked by the env, run on env teardown unless finalized earlier */
+  public createFinalizer (
+    envObject: Env,
+    finalize_callback: napi_finalize,
+    finalize_data: void_p,
+    finalize_hint: void_p
+  ): RefBase {
+    return new RefBase(envObject, 0, Ownership.kRuntime, finalize_callback, finalize_data, finalize_hint)
+  }
+
   createDeferred<T = any> (value: IDeferrdValue<T>): Deferred<T> {
     return Deferred.create(this, value)
   }
@@ -194,35 +280,71 @@ export class Context {
     return newEnv(this, filename, moduleApiVersion, makeDynCall_vppp, makeDynCall_vp, abort, nodeBinding)
   }
 
-  getCurrentScope (): HandleScope | null {
+  getCurrentScope (): number {
     return this.scopeStore.currentScope
   }
 
-  addToCurrentScope<V> (value: V): Handle<V> {
-    return this.scopeStore.currentScope.add(value)
+  addToCurrentScope (value: any): napi_value {
+    return this.scopeStore.add(value)
+  }
+
+  addExternalToCurrentScope (envObject: Env, data: void_p): napi_value {
+    return this.scopeStore.addExternal(envObject, data)
   }
 
-  openScope (envObject: Env): HandleScope {
+  openScope (envObject: Env): number {
     return this.scopeStore.openScope(envObject)
   }
 
-  closeScope (envObject: Env, _scope?: HandleScope): void {
+  closeScope (envObject: Env, _scope?: number): void {
     this.scopeStore.closeScope(envObject)
   }
 
-  ensureHandle<S> (value: S): Handle<S> {
-    switch (value as any) {
-      case undefined: return HandleStore.UNDEFINED as any
-      case null: return HandleStore.NULL as any
-      case true: return HandleStore.TRUE as any
-      case false: return HandleStore.FALSE as any
-      case _global: return HandleStore.GLOBAL as any
+  releasePersistentHandle (id: napi_value): void {
+    this.handleStore.releasePersistent(id)
+    if (this.scopeStore.currentScope === 0) {
+      this.handleStore.flushPersistent()
+    }
+  }
+
+  ensureHandle (value: any): napi_value {
+    switch (value) {
+      case undefined: return GlobalHandle.UNDEFINED
+      case null: return GlobalHandle.NULL
+      case true: return GlobalHandle.TRUE
+      case false: return GlobalHandle.FALSE
+      case _global: return GlobalHandle.GLOBAL
       default: break
     }
 
+    if (this.taggedValues && typeof value === 'number' && HandleStore.isTaggable(value)) {
+      return HandleStore.encodeTagged(value)
+    }
+
     return this.addToCurrentScope(value)
   }
 
+  getStats (): RuntimeStats {
+    let finalizerCount = 0
+    let pendingFinalizerCount = 0
+    this.envStore.forEach((envObject) => {
+      finalizerCount += RefTracker.count(envObject.finalizing_reflist)
+      pendingFinalizerCount += envObject.pendingFinalizers.length
+    })
+    return {
+      handleCount: this.handleStore.size,
+      peakHandleCount: this.handleStore.peakSize,
+      persistentHandleCount: this.handleStore.persistentSize,
+      scopeDepth: this.scopeStore.currentScope,
+      peakScopeDepth: this.scopeStore.peakScope,
+      referenceCount: this.refStore.count,
+      deferredCount: this.deferredStore.count,
+      finalizerCount,
+      pendingFinalizerCount,
+      handleCapacity: this.handleStore.capacity
+    }
+  }
+
   public addCleanupHook (envObject: Env, fn: CleanupHookCallbackFunction, arg: number): void {
     this.cleanupQueue.add(envObject, fn, arg)
   }
@@ -247,14 +369,16 @@ export class Context {
 
   public setCanCallIntoJs (value: boolean): void {
     this._canCallIntoJs = value
+    this._jsCallable = value && !this._isStopping
   }
 
   public setStopping (value: boolean): void {
     this._isStopping = value
+    this._jsCallable = this._canCallIntoJs && !value
   }
 
   public canCallIntoJs (): boolean {
-    return this._canCallIntoJs && !this._isStopping
+    return this._jsCallable
   }
 
   public destroy (): void {
@@ -266,8 +390,8 @@ export class Context {
 
 let defaultContext: Context
 
-export function createContext (): Context {
-  return new Context()
+export function createContext (options?: ContextOptions): Context {
+  return new Context(options)
 }
 
 export function getDefaultContext (): Context {
@@ -1,160 +1,294 @@
-import type { Env } from './env'
-import { isReferenceType, _global, _Buffer } from './util'
+import { _global } from './util'
 
-export class Handle<S> {
-  public constructor (
-    public id: number,
-    public value: S
-  ) {}
+export function External (this: any): void {
+  Object.setPrototypeOf(this, null)
+}
+External.prototype = null as any
 
-  public data (envObject: Env): void_p {
-    return envObject.getObjectBinding(this.value as any).data
-  }
+export interface HandleStoreOptions {
+  /** slots always kept after trimming */
+  minCapacity?: number
+  /** trim as soon as all scopes are closed if more slots than this are held */
+  maxCapacity?: number
+  /** trim after this many consecutive top level scopes using under a quarter of the slots */
+  shrinkAfter?: number
+  /** interned property keys held before the oldest one is released */
+  maxPropertyKeys?: number
+}
 
-  public isNumber (): boolean {
-    return typeof this.value === 'number'
-  }
+// called in the middle of other operations, so neither method may run user JS,
+// call into wasm (which may grow memory) or throw
+export interface TypeRecorder {
+  /** a scope handle was created or swapped */
+  record (id: number, value: any): void
+  /** the scope handles in [start, end) were released */
+  erase (start: number, end: number): void
+}
 
-  public isBigInt (): boolean {
-    return typeof this.value === 'bigint'
-  }
+export class HandleStore {
+  public static MIN_ID = 6 as const
+  public static PERSISTENT_BASE = 0x40000000 as const
+  public static TAGGED_BIT = 0x80000000 as const
+
+  private readonly _values: any[] = [
+    undefined,
+    undefined,
+    null,
+    false,
+    true,
+    _global
+  ]
 
-  public isString (): boolean {
-    return typeof this.value === 'string'
+  private _next: number = HandleStore.MIN_ID
+  // _next only goes down in erase(), so recording it there is enough
+  private _peak: number = HandleStore.MIN_ID
+  // peak since the last time all scopes were closed
+  private _cyclePeak: number = HandleStore.MIN_ID
+  private _idleCycles: number = 0
+
+  private readonly _minCapacity: number
+  private readonly _maxCapacity: number
+  private readonly _shrinkAfter: number
+
+  // handles that outlive scopes, ids start from PERSISTENT_BASE
+  private readonly _persistentValues: any[] = []
+  private readonly _persistentFreeList: number[] = []
+  private readonly _persistentReleased: number[] = []
+
+  // interned property keys, oldest first, each held by a persistent handle
+  private readonly _propertyKeys: Map<string, napi_value> = new Map()
+  private readonly _maxPropertyKeys: number
+
+  private readonly _typeRecorders: TypeRecorder[] = []
+
+  // UTF-8 bytes of the last scope handle whose length was queried,
+  // taken by the copy that usually follows
+  private _utf8BytesId = 0
+  private _utf8Bytes: Uint8Array | undefined = undefined
+
+  public constructor (options: HandleStoreOptions = {}) {
+    this._minCapacity = Math.max(HandleStore.MIN_ID, (typeof options.minCapacity === 'number' ? options.minCapacity : 1024))
+    this._maxCapacity = Math.max(this._minCapacity, (typeof options.maxCapacity === 'number' ? options.maxCapacity : 65536))
+    this._shrinkAfter = Math.max(1, (typeof options.shrinkAfter === 'number' ? options.shrinkAfter : 16))
+    this._maxPropertyKeys = Math.max(1, (typeof options.maxPropertyKeys === 'number' ? options.maxPropertyKeys : 4096))
   }
 
-  public isFunction (): boolean {
-    return typeof this.value === 'function'
+  public push (value: any): napi_value {
+    const next = this._next
+    this._values[next] = value
+    this._next = next + 1
+    if (this._typeRecorders.length !== 0) this._recordType(next, value)
+    return next
   }
 
-  public isExternal (): boolean {
-    return (isReferenceType(this.value) && Object.getPrototypeOf(this.value) === null)
+  // recorders mirror the type of scope handles into wasm memory
+  public addTypeRecorder (recorder: TypeRecorder): void {
+    if (this._typeRecorders.indexOf(recorder) !== -1) return
+    this._typeRecorders.push(recorder)
+    const values = this._values
+    for (let i = HandleStore.MIN_ID; i < this._next; ++i) {
+      recorder.record(i, values[i])
+    }
   }
 
-  public isObject (): boolean {
-    return typeof this.value === 'object' && this.value !== null
+  private _recordType (id: number, value: any): void {
+    const recorders = this._typeRecorders
+    for (let i = 0; i < recorders.length; ++i) {
+      recorders[i].record(id, value)
+    }
   }
 
-  public isArray (): boolean {
-    return Array.isArray(this.value)
+  public erase (start: number, end: number): void {
+    const next = this._next
+    if (next > this._cyclePeak) {
+      this._cyclePeak = next
+      if (next > this._peak) {
+        this._peak = next
+      }
+    }
+    this._next = start
+    const values = this._values
+    for (let i = start; i < end; ++i) {
+      values[i] = undefined
+    }
+    if (this._utf8BytesId >= start && this._utf8BytesId < end) {
+      this._utf8BytesId = 0
+      this._utf8Bytes = undefined
+    }
+    const recorders = this._typeRecorders
+    for (let i = 0; i < recorders.length; ++i) {
+      recorders[i].erase(start, end)
+    }
   }
 
-  public isArrayBuffer (): boolean {
-    return (this.value instanceof ArrayBuffer)
+  public get (id: Ptr): any {
+    if (id < HandleStore.PERSISTENT_BASE) {
+      if (id >= 0) return this._values[id as any]
+    } else if (id < HandleStore.TAGGED_BIT) {
+      return this._persistentValues[Number(id) - HandleStore.PERSISTENT_BASE]
+    }
+    return HandleStore.decodeTagged(id as number)
   }
 
-  public isTypedArray (): boolean {
-    return (ArrayBuffer.isView(this.value)) && !(this.value instanceof DataView)
+  // int31 immediates are tagged with bit 31 and never stored,
+  // it may arrive signed or unsigned depending on how the pointer was passed
+  public static isTaggable (value: number): boolean {
+    return (value | 0) === value && value >= -0x40000000 && value < 0x40000000 && (value !== 0 || 1 / value > 0)
   }
 
-  public isBuffer (): boolean {
-    return typeof _Buffer === 'function' && _Buffer.isBuffer(this.value)
+  public static encodeTagged (value: number): napi_value {
+    return (value & 0x7FFFFFFF) | HandleStore.TAGGED_BIT
   }
 
-  public isDataView (): boolean {
-    return (this.value instanceof DataView)
+  public static decodeTagged (id: number): number {
+    return (id << 1) >> 1
   }
 
-  public isDate (): boolean {
-    return (this.value instanceof Date)
+  public get size (): number {
+    return this._next - HandleStore.MIN_ID
   }
 
-  public isPromise (): boolean {
-    return (this.value instanceof Promise)
+  public get peakSize (): number {
+    return Math.max(this._next, this._peak) - HandleStore.MIN_ID
   }
 
-  public isBoolean (): boolean {
-    return typeof this.value === 'boolean'
+  public get capacity (): number {
+    return this._values.length
   }
 
-  public isUndefined (): boolean {
-    return this.value === undefined
-  }
+  // called when all scopes are closed
+  public shrink (): void {
+    const next = this._next
+    const used = Math.max(next, this._cyclePeak)
+    this._cyclePeak = next
+    const capacity = this._values.length
+    if (capacity <= this._minCapacity) return
+
+    if (capacity > this._maxCapacity) {
+      this._idleCycles = 0
+      this._values.length = Math.max(this._minCapacity, next)
+      return
+    }
 
-  public isSymbol (): boolean {
-    return typeof this.value === 'symbol'
-  }
+    if (used * 4 > capacity) {
+      this._idleCycles = 0
+      return
+    }
 
-  public isNull (): boolean {
-    return this.value === null
+    if (++this._idleCycles >= this._shrinkAfter) {
+      this._idleCycles = 0
+      this._values.length = Math.max(this._minCapacity, used * 2, next)
+    }
   }
 
-  public dispose (): void {
-    this.value = undefined!
+  public get persistentSize (): number {
+    return this._persistentValues.length - this._persistentFreeList.length
   }
-}
 
-export class ConstHandle<S extends undefined | null | boolean | typeof globalThis> extends Handle<S> {
-  public constructor (id: number, value: S) {
-    super(id, value)
+  public pushPersistent (value: any): napi_value {
+    const values = this._persistentValues
+    const freeList = this._persistentFreeList
+    let index: number
+    if (freeList.length > 0) {
+      index = freeList.pop()!
+      values[index] = value
+    } else {
+      index = values.length
+      values.push(value)
+    }
+    return HandleStore.PERSISTENT_BASE + index
   }
 
-  public override dispose (): void {}
-}
-
-export function External (this: any): void {
-  Object.setPrototypeOf(this, null)
-}
-External.prototype = null as any
-
-export class HandleStore {
-  public static UNDEFINED = new ConstHandle(GlobalHandle.UNDEFINED, undefined)
-  public static NULL = new ConstHandle(GlobalHandle.NULL, null)
-  public static FALSE = new ConstHandle(GlobalHandle.FALSE, false)
-  public static TRUE = new ConstHandle(GlobalHandle.TRUE, true)
-  public static GLOBAL = new ConstHandle(GlobalHandle.GLOBAL, _global)
-
-  public static MIN_ID = 6 as const
+  // the slot is kept until flushPersistent() because the id may
+  // still be used in the scopes which are currently open
+  public releasePersistent (id: napi_value): void {
+    this._persistentReleased.push(id - HandleStore.PERSISTENT_BASE)
+  }
 
-  private readonly _values: Array<Handle<any>> = [
-    undefined!,
-    HandleStore.UNDEFINED,
-    HandleStore.NULL,
-    HandleStore.FALSE,
-    HandleStore.TRUE,
-    HandleStore.GLOBAL
-  ]
+  public flushPersistent (): void {
+    const released = this._persistentReleased
+    const len = released.length
+    if (len === 0) return
+    const values = this._persistentValues
+    const freeList = this._persistentFreeList
+    for (let i = 0; i < len; ++i) {
+      const index = released[i]
+      values[index] = undefined
+      freeList.push(index)
+    }
+    released.length = 0
+  }
 
-  private _next: number = HandleStore.MIN_ID
+  public get propertyKeySize (): number {
+    return this._propertyKeys.size
+  }
 
-  public push<S> (value: S): Handle<S> {
-    let h: Handle<S>
-    const next = this._next
-    const values = this._values
-    if (next < values.length) {
-      h = values[next]
-      h.value = value
-    } else {
-      h = new Handle(next, value)
-      values[next] = h
+  public pushPropertyKey (key: string): napi_value {
+    const keys = this._propertyKeys
+    let id = keys.get(key)
+    if (id === undefined) {
+      if (keys.size >= this._maxPropertyKeys) {
+        const oldest = keys.entries().next().value!
+        keys.delete(oldest[0])
+        this.releasePersistent(oldest[1])
+      }
+      id = this.pushPersistent(key)
+      keys.set(key, id)
     }
-    this._next++
-    return h
+    return id
   }
 
-  public erase (start: number, end: number): void {
-    this._next = start
-    const values = this._values
-    for (let i = start; i < end; ++i) {
-      values[i].dispose()
-    }
+  public releasePropertyKeys (): void {
+    this._propertyKeys.forEach((id) => {
+      this.releasePersistent(id)
+    })
+    this._propertyKeys.clear()
   }
 
-  public get (id: Ptr): Handle<any> | undefined {
-    return this._values[id as any]
+  public setUTF8Bytes (id: napi_value, bytes: Uint8Array): void {
+    id = Number(id)
+    // persistent slots are recycled without going through erase
+    if (id < HandleStore.MIN_ID || id >= HandleStore.PERSISTENT_BASE) return
+    this._utf8BytesId = id
+    this._utf8Bytes = bytes
+  }
+
+  /** returns undefined if the length of `id` was not queried last */
+  public takeUTF8Bytes (id: napi_value): Uint8Array | undefined {
+    if (this._utf8BytesId === 0 || this._utf8BytesId !== Number(id)) return undefined
+    const bytes = this._utf8Bytes
+    this._utf8BytesId = 0
+    this._utf8Bytes = undefined
+    return bytes
   }
 
   public swap (a: number, b: number): void {
+    if (this._utf8BytesId === a || this._utf8BytesId === b) {
+      this._utf8BytesId = 0
+      this._utf8Bytes = undefined
+    }
     const values = this._values
-    const h = values[a]
+    const value = values[a]
     values[a] = values[b]
-    values[a]!.id = Number(a)
-    values[b] = h
-    h.id = Number(b)
+    values[b] = value
+    if (this._typeRecorders.length !== 0) {
+      this._recordType(a, values[a])
+      this._recordType(b, value)
+    }
   }
 
   public dispose (): void {
     this._values.length = HandleStore.MIN_ID
     this._next = HandleStore.MIN_ID
+    this._peak = HandleStore.MIN_ID
+    this._cyclePeak = HandleStore.MIN_ID
+    this._idleCycles = 0
+    this._persistentValues.length = 0
+    this._persistentFreeList.length = 0
+    this._persistentReleased.length = 0
+    this._propertyKeys.clear()
+    this._typeRecorders.length = 0
+    this._utf8BytesId = 0
+    this._utf8Bytes = undefined
   }
 }
@@ -25,6 +25,14 @@ export class RefTracker {
     this._next = null
   }
 
+  public static count (list: RefTracker): number {
+    let n = 0
+    for (let node = list._next; node !== null; node = node._next) {
+      n++
+    }
+    return n
+  }
+
   public static finalizeAll (list: RefTracker): void {
     while (list._next !== null) {
       list._next.finalize()
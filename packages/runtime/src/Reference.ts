@@ -2,20 +2,21 @@ import type { IStoreValue } from './Store'
 import type { Env } from './env'
 import { RefBase } from './RefBase'
 import { Persistent } from './Persistent'
-import type { Handle } from './Handle'
+import { isReferenceType } from './util'
 
 function weakCallback (ref: Reference): void {
   ref.persistent.reset()
   ref.envObject.enqueueFinalizer(ref)
 }
 
-function canBeHeldWeakly (value: Handle<any>): boolean {
-  return value.isObject() || value.isFunction() || value.isSymbol()
+function canBeHeldWeakly (value: any): boolean {
+  return isReferenceType(value) || typeof value === 'symbol'
 }
 
 export class Reference extends RefBase implements IStoreValue {
   public id: number
   private canBeWeak!: boolean
+  private _handle: napi_value = 0
 
   public static create (
     envObject: Env,
@@ -26,11 +27,11 @@ export class Reference extends RefBase implements IStoreValue {
     finalize_data: void_p = 0,
     finalize_hint: void_p = 0
   ): Reference {
-    const handle = envObject.ctx.handleStore.get(handle_id)!
+    const value = envObject.ctx.handleStore.get(handle_id)
     const ref = new Reference(envObject, initialRefcount, ownership, finalize_callback, finalize_data, finalize_hint)
     envObject.ctx.refStore.add(ref)
-    ref.canBeWeak = canBeHeldWeakly(handle)
-    ref.persistent = new Persistent(handle.value)
+    ref.canBeWeak = canBeHeldWeakly(value)
+    ref.persistent = new Persistent(value)
 
     if (initialRefcount === 0) {
       ref._setWeak()
@@ -74,6 +75,7 @@ export class Reference extends RefBase implements IStoreValue {
     const oldRefcount = this.refCount()
     const refcount = super.unref()
     if (oldRefcount === 1 && refcount === 0) {
+      this._releaseHandle()
       this._setWeak()
     }
     return refcount
@@ -83,9 +85,22 @@ export class Reference extends RefBase implements IStoreValue {
     if (this.persistent.isEmpty()) {
       return 0
     }
+    if (this._handle !== 0) {
+      return this._handle
+    }
     const obj = this.persistent.deref()
-    const handle = this.envObject.ensureHandle(obj)
-    return handle.id
+    if (this.refCount() > 0) {
+      this._handle = this.envObject.ctx.handleStore.pushPersistent(obj)
+      return this._handle
+    }
+    return this.envObject.ensureHandle(obj)
+  }
+
+  private _releaseHandle (): void {
+    if (this._handle !== 0) {
+      this.envObject.ctx.releasePersistentHandle(this._handle)
+      this._handle = 0
+    }
   }
 
   private _setWeak (): void {
@@ -97,12 +112,14 @@ export class Reference extends RefBase implements IStoreValue {
   }
 
   public override finalize (): void {
+    this._releaseHandle()
     this.persistent.reset()
     super.finalize()
   }
 
   public override dispose (): void {
     if (this.id === 0) return
+    this._releaseHandle()
     this.persistent.reset()
     this.envObject.ctx.refStore.remove(this.id)
     super.dispose()
@@ -1,65 +1,122 @@
 import type { Env } from './env'
-import { HandleStore } from './Handle'
-import { HandleScope } from './HandleScope'
+import { External, HandleStore } from './Handle'
+
+const INITIAL_DEPTH = 16
 
 export class ScopeStore {
-  private readonly _rootScope: HandleScope
-  public currentScope: HandleScope
+  // scope `id` is its nesting depth, the root scope is 0
+  private readonly _start: number[]
+  private readonly _end: number[]
+  private readonly _escapeCalled: number[]
+
+  public currentScope: number
+  public peakScope: number
 
-  constructor () {
-    this._rootScope = new HandleScope(null!, 0, null, 1, HandleStore.MIN_ID)
-    this.currentScope = this._rootScope
+  public constructor (
+    private readonly _handleStore: HandleStore
+  ) {
+    this._start = new Array<number>(INITIAL_DEPTH).fill(0)
+    this._end = new Array<number>(INITIAL_DEPTH).fill(0)
+    this._escapeCalled = new Array<number>(INITIAL_DEPTH).fill(0)
+    this._start[0] = 1
+    this._end[0] = HandleStore.MIN_ID
+    this.currentScope = 0
+    this.peakScope = 0
   }
 
-  get (id: number): HandleScope | undefined {
+  public has (id: number): boolean {
     id = Number(id)
-    let scope = this.currentScope
-    while (scope !== this._rootScope) {
-      if (scope.id === id) {
-        return scope
-      }
-      scope = scope.parent!
-    }
-    return undefined
+    return id > 0 && id <= this.currentScope
+  }
+
+  public add (value: any): napi_value {
+    const h = this._handleStore.push(value)
+    this._end[this.currentScope]++
+    return h
   }
 
-  openScope (envObject: Env): HandleScope {
-    const currentScope = this.currentScope
-    let scope = currentScope.child
+  public addExternal (envObject: Env, data: void_p): napi_value {
+    const value = new (External as any)()
+    const h = this.add(value)
+    const binding = envObject.initObjectBinding(value)
+    binding.data = data
+    return h
+  }
 
-    if (scope !== null) {
-      scope.start = scope.end = currentScope.end
-      scope._escapeCalled = false
-    } else {
-      scope = new HandleScope(envObject.ctx.handleStore, currentScope.id + 1, currentScope, currentScope.end)
+  public openScope (envObject: Env): number {
+    const parent = this.currentScope
+    const scope = parent + 1
+    if (scope === this._start.length) {
+      this._grow()
     }
+    const end = this._end[parent]
+    this._start[scope] = end
+    this._end[scope] = end
+    this._escapeCalled[scope] = 0
     this.currentScope = scope
+    if (scope > this.peakScope) {
+      this.peakScope = scope
+    }
 
     envObject.openHandleScopes++
     return scope
   }
 
-  closeScope (envObject: Env): void {
+  public closeScope (envObject: Env): void {
     if (envObject.openHandleScopes === 0) return
     const scope = this.currentScope
-    this.currentScope = scope.parent!
-    scope.dispose()
+    const start = this._start[scope]
+    const end = this._end[scope]
+    if (start !== end) {
+      this._handleStore.erase(start, end)
+    }
+    this.currentScope = scope - 1
     envObject.openHandleScopes--
+    if (scope === 1) {
+      this._handleStore.flushPersistent()
+      this._handleStore.shrink()
+    }
+  }
+
+  public escapeCalled (scope: number): boolean {
+    return this._escapeCalled[Number(scope)] !== 0
+  }
+
+  public escape (scope: number, handle: number): napi_value {
+    scope = Number(scope)
+    if (this._escapeCalled[scope] !== 0) return 0
+    this._escapeCalled[scope] = 1
+
+    // constant and persistent handles are not owned by any scope
+    if (handle < HandleStore.MIN_ID || handle >= HandleStore.PERSISTENT_BASE) {
+      return handle
+    }
+
+    const start = this._start[scope]
+    if (handle < start || handle >= this._end[scope]) {
+      return 0
+    }
+
+    this._handleStore.swap(handle, start)
+    this._start[scope] = start + 1
+    this._end[scope - 1]++
+    return start
   }
 
-  dispose (): void {
-    let scope: HandleScope | null = this.currentScope
-    while (scope !== null) {
-      scope.handleStore = null!
-      scope.id = 0
-      scope.parent = null
-      scope.start = HandleStore.MIN_ID
-      scope.end = HandleStore.MIN_ID
-      scope._escapeCalled = false
-      const child: HandleScope | null = scope.child
-      scope.child = null
-      scope = child
+  private _grow (): void {
+    const capacity = this._start.length
+    for (let i = 0; i < capacity; ++i) {
+      this._start.push(0)
+      this._end.push(0)
+      this._escapeCalled.push(0)
     }
-    this.currentScope = null!
+  }
+
+  public dispose (): void {
+    this._start.length = this._end.length = this._escapeCalled.length = INITIAL_DEPTH
+    this._start[0] = 1
+    this._end[0] = HandleStore.MIN_ID
+    this.currentScope = 0
+    this.peakScope = 0
   }
 }
@@ -8,8 +8,14 @@ export interface IReusableStoreValue extends IStoreValue {
   init (...args: any[]): void
 }
 
+// id = generation << INDEX_BITS | index, always a positive int32
+const INDEX_BITS = 24
+const INDEX_MASK = (1 << INDEX_BITS) - 1
+const GENERATION_MASK = 0x7f
+
 export class Store<V extends IStoreValue> {
   protected _values: Array<V | undefined>
+  // ids to hand out next for the removed slots, used as a stack
   private _freeList: number[]
   private _size: number
 
@@ -23,9 +29,12 @@ export class Store<V extends IStoreValue> {
   public add (value: V): void {
     let id: number
     if (this._freeList.length) {
-      id = this._freeList.shift()!
+      id = this._freeList.pop()!
     } else {
       id = this._size
+      if (id > INDEX_MASK) {
+        throw new RangeError('Store is full')
+      }
       this._size++
       const capacity = this._values.length
       if (id >= capacity) {
@@ -33,23 +42,39 @@ export class Store<V extends IStoreValue> {
       }
     }
     value.id = id
-    this._values[id] = value
+    this._values[id & INDEX_MASK] = value
   }
 
   public get (id: Ptr): V | undefined {
-    return this._values[id as any]
+    id = Number(id)
+    const value = this._values[id & INDEX_MASK]
+    return (value !== undefined && value.id === id) ? value : undefined
   }
 
   public has (id: Ptr): boolean {
-    return this._values[id as any] !== undefined
+    return this.get(id) !== undefined
+  }
+
+  public get count (): number {
+    return this._size - 1 - this._freeList.length
+  }
+
+  public forEach (callback: (value: V) => void): void {
+    for (let i = 1; i < this._size; ++i) {
+      const value = this._values[i]
+      if (value !== undefined) callback(value)
+    }
   }
 
   public remove (id: Ptr): void {
-    const value = this._values[id as any]
-    if (value) {
+    id = Number(id)
+    const index = id & INDEX_MASK
+    const value = this._values[index]
+    if (value !== undefined && value.id === id) {
       value.id = 0
-      this._values[id as any] = undefined
-      this._freeList.push(Number(id))
+      this._values[index] = undefined
+      const generation = ((id >>> INDEX_BITS) + 1) & GENERATION_MASK
+      this._freeList.push((generation << INDEX_BITS) | index)
     }
   }
 
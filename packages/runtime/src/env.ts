@@ -1,4 +1,3 @@
-import type { Handle } from './Handle'
 import type { Context } from './Context'
 import type { IStoreValue } from './Store'
 import {
@@ -32,6 +31,20 @@ export interface IReferenceBinding {
   data: void_p
 }
 
+export interface ILastError {
+  errorCode: napi_status
+  engineErrorCode: uint32_t
+  engineReserved: Ptr
+}
+
+export interface IExternalString {
+  value: string
+  // size of the buffer, counted against the env's retained bytes
+  bytes: number
+  // one finalizer per buffer handed over for this string
+  finalizers: RefBase[]
+}
+
 export class Env implements IStoreValue {
   public id: number
 
@@ -48,10 +61,14 @@ export class Env implements IStoreValue {
 
   public pendingFinalizers: RefTracker[] = []
 
-  public lastError = {
+  // strings created from external buffers by encoding, address and length, oldest first
+  public externalStrings = new Map<string, IExternalString>()
+  public externalStringBytes = 0
+
+  public lastError: ILastError = {
     errorCode: napi_status.napi_ok,
-    engineErrorCode: 0 as uint32_t,
-    engineReserved: 0 as Ptr
+    engineErrorCode: 0,
+    engineReserved: 0
   }
 
   public constructor (
@@ -84,12 +101,12 @@ export class Env implements IStoreValue {
     }
   }
 
-  public ensureHandle<S> (value: S): Handle<S> {
+  public ensureHandle (value: any): napi_value {
     return this.ctx.ensureHandle(value)
   }
 
   public ensureHandleId (value: any): napi_value {
-    return this.ensureHandle(value).id
+    return this.ctx.ensureHandle(value)
   }
 
   public clearLastError (): napi_status {
@@ -118,6 +135,12 @@ export class Env implements IStoreValue {
     const openHandleScopesBefore = this.openHandleScopes
     this.clearLastError()
     const r = fn(this)
+    this.leaveModule(openHandleScopesBefore, handleException)
+    return r
+  }
+
+  // callers must record openHandleScopes and clear the last error before calling into the module
+  public leaveModule (openHandleScopesBefore: number, handleException: (envObject: Env, value: any) => void = handleThrow): void {
     if (openHandleScopesBefore !== this.openHandleScopes) {
       this.abort('open_handle_scopes != open_handle_scopes_before')
     }
@@ -125,7 +148,6 @@ export class Env implements IStoreValue {
       const err = this.tryCatch.extractException()!
       handleException(this, err)
     }
-    return r
   }
 
   /** @virtual */
@@ -159,6 +181,9 @@ export class Env implements IStoreValue {
   public deleteMe (): void {
     RefBase.finalizeAll(this.finalizing_reflist)
     RefBase.finalizeAll(this.reflist)
+    // their finalizers ran with the lists above
+    this.externalStrings.clear()
+    this.externalStringBytes = 0
 
     this.tryCatch.extractException()
     this.ctx.envStore.remove(this.id)
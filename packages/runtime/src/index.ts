@@ -1,11 +1,10 @@
 export { CallbackInfo, CallbackInfoStack } from './CallbackInfo'
-export { createContext, getDefaultContext, Context, type CleanupHookCallbackFunction } from './Context'
+export { createContext, getDefaultContext, Context, type CleanupHookCallbackFunction, type ContextOptions, type RuntimeStats } from './Context'
 export { Deferred, type IDeferrdValue } from './Deferred'
-export { Env, NodeEnv, type IReferenceBinding } from './env'
+export { Env, NodeEnv, type IReferenceBinding, type ILastError, type IExternalString } from './env'
 export { EmnapiError, NotSupportWeakRefError, NotSupportBufferError } from './errors'
 export { Finalizer } from './Finalizer'
-export { Handle, ConstHandle, HandleStore } from './Handle'
-export { HandleScope } from './HandleScope'
+export { HandleStore, type HandleStoreOptions, type TypeRecorder } from './Handle'
 export { RefBase } from './RefBase'
 export { Persistent } from './Persistent'
 export { Reference } from './Reference'
@@ -61,6 +61,19 @@ declare interface emnapi_emscripten_version {
   patch: uint32_t
 }
 
+declare interface emnapi_runtime_stats {
+  handle_count: uint32_t
+  peak_handle_count: uint32_t
+  persistent_handle_count: uint32_t
+  scope_depth: uint32_t
+  peak_scope_depth: uint32_t
+  reference_count: uint32_t
+  deferred_count: uint32_t
+  finalizer_count: uint32_t
+  pending_finalizer_count: uint32_t
+  handle_capacity: uint32_t
+}
+
 declare const enum napi_status {
   napi_ok,
   napi_invalid_arg,
@@ -153,6 +166,26 @@ declare const enum napi_key_conversion {
   napi_key_numbers_to_strings
 }
 
+declare const enum emnapi_value_descriptor_type {
+  emnapi_value_int32,
+  emnapi_value_uint32,
+  emnapi_value_double,
+  emnapi_value_bool,
+  emnapi_value_string_utf8
+}
+
+declare const enum emnapi_field_type {
+  emnapi_field_int8,
+  emnapi_field_uint8,
+  emnapi_field_int16,
+  emnapi_field_uint16,
+  emnapi_field_int32,
+  emnapi_field_uint32,
+  emnapi_field_float,
+  emnapi_field_double,
+  emnapi_field_bool
+}
+
 declare const enum emnapi_memory_view_type {
   emnapi_int8_array,
   emnapi_uint8_array,
@@ -90,6 +90,14 @@ export function isReferenceType (v: any): v is object {
   return (typeof v === 'object' && v !== null) || typeof v === 'function'
 }
 
+export function isExternal (v: any): boolean {
+  return isReferenceType(v) && Object.getPrototypeOf(v) === null
+}
+
+export function isTypedArray (v: any): v is ArrayBufferView {
+  return ArrayBuffer.isView(v) && !(v instanceof DataView)
+}
+
 const _require = /*#__PURE__*/ (function () {
   let nativeRequire
 
@@ -12,8 +12,11 @@ module.exports = load('conversion').then(test => {
 
   const testSym = Symbol('test')
 
+  // arguments sit in scope slots, not in the constant true/false handles,
+  // so these also cover the fallback of the tagged value build
   assert.strictEqual(test.asBool(false), false)
   assert.strictEqual(test.asBool(true), true)
+  assert.throws(() => test.asBool(new Boolean(true)), boolExpected)
   assert.throws(() => test.asBool(undefined), boolExpected)
   assert.throws(() => test.asBool(null), boolExpected)
   assert.throws(() => test.asBool(Number.NaN), boolExpected)
@@ -99,6 +99,114 @@ static napi_value NullArrayBuffer(napi_env env, napi_callback_info info) {
   return output_view;
 }
 
+static napi_value LazyClassConstructor(napi_env env, napi_callback_info info) {
+  napi_value this_arg;
+  NAPI_CALL(env, napi_get_cb_info(env, info, NULL, NULL, &this_arg, NULL));
+  return this_arg;
+}
+
+static napi_value LazyClassMethod(napi_env env, napi_callback_info info) {
+  void* data;
+  napi_value result;
+  NAPI_CALL(env, napi_get_cb_info(env, info, NULL, NULL, NULL, &data));
+  NAPI_CALL(env, napi_create_uint32(env, (uint32_t) (uintptr_t) data, &result));
+  return result;
+}
+
+static napi_value DefineLazyClass(napi_env env, napi_callback_info info) {
+  napi_property_descriptor properties[] = {
+    { "one", NULL, LazyClassMethod, NULL, NULL, NULL, napi_default_method, (void*) 1 },
+    { "two", NULL, LazyClassMethod, NULL, NULL, NULL, napi_default_method, (void*) 2 },
+    { "three", NULL, LazyClassMethod, NULL, NULL, NULL, napi_default_method | napi_static, (void*) 3 },
+  };
+  napi_value result;
+  NAPI_CALL(env, napi_define_class(env, "LazyClass", NAPI_AUTO_LENGTH,
+      LazyClassConstructor, NULL,
+      sizeof(properties) / sizeof(*properties), properties, &result));
+  return result;
+}
+
+static napi_value GetRuntimeStats(napi_env env, napi_callback_info info) {
+  emnapi_runtime_stats stats;
+  napi_value result, value;
+  NAPI_CALL(env, emnapi_get_runtime_stats(env, &stats));
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+#define SET_STATS_FIELD(field) \
+  do { \
+    NAPI_CALL(env, napi_create_uint32(env, stats.field, &value)); \
+    NAPI_CALL(env, napi_set_named_property(env, result, #field, value)); \
+  } while (0)
+
+  SET_STATS_FIELD(handle_count);
+  SET_STATS_FIELD(peak_handle_count);
+  SET_STATS_FIELD(persistent_handle_count);
+  SET_STATS_FIELD(scope_depth);
+  SET_STATS_FIELD(peak_scope_depth);
+  SET_STATS_FIELD(reference_count);
+  SET_STATS_FIELD(deferred_count);
+  SET_STATS_FIELD(finalizer_count);
+  SET_STATS_FIELD(pending_finalizer_count);
+  SET_STATS_FIELD(handle_capacity);
+
+#undef SET_STATS_FIELD
+
+  return result;
+}
+
+static napi_value LeakHandles(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  uint32_t count, i;
+  napi_value value;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 1, "Wrong number of arguments");
+  NAPI_CALL(env, napi_get_value_uint32(env, args[0], &count));
+
+  for (i = 0; i < count; i++) {
+    NAPI_CALL(env, napi_create_object(env, &value));
+  }
+
+  return GetRuntimeStats(env, info);
+}
+
+static napi_value NestHandleScopesImpl(napi_env env,
+                                       napi_callback_info info,
+                                       uint32_t depth,
+                                       uint32_t count) {
+  napi_escapable_handle_scope scope;
+  napi_value value, result;
+  uint32_t i;
+  NAPI_CALL(env, napi_open_escapable_handle_scope(env, &scope));
+
+  for (i = 0; i < count; i++) {
+    NAPI_CALL(env, napi_create_object(env, &value));
+  }
+
+  result = depth > 1
+      ? NestHandleScopesImpl(env, info, depth - 1, count)
+      : GetRuntimeStats(env, info);
+  NAPI_ASSERT(env, result != NULL, "Nested call failed");
+  NAPI_CALL(env, napi_escape_handle(env, scope, result, &result));
+  NAPI_CALL(env, napi_close_escapable_handle_scope(env, scope));
+  return result;
+}
+
+// opens `depth` nested scopes holding `count` handles each,
+// returns the stats taken in the innermost one
+static napi_value NestHandleScopes(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  uint32_t depth, count;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 2, "Wrong number of arguments");
+  NAPI_CALL(env, napi_get_value_uint32(env, args[0], &depth));
+  NAPI_CALL(env, napi_get_value_uint32(env, args[1], &count));
+  NAPI_ASSERT(env, depth > 0, "depth must be positive");
+
+  return NestHandleScopesImpl(env, info, depth, count);
+}
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
 #ifdef __EMSCRIPTEN__
@@ -115,6 +223,10 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("External", External),
     DECLARE_NAPI_PROPERTY("NullArrayBuffer", NullArrayBuffer),
     DECLARE_NAPI_PROPERTY("GrowMemory", GrowMemory),
+    DECLARE_NAPI_PROPERTY("DefineLazyClass", DefineLazyClass),
+    DECLARE_NAPI_PROPERTY("GetRuntimeStats", GetRuntimeStats),
+    DECLARE_NAPI_PROPERTY("LeakHandles", LeakHandles),
+    DECLARE_NAPI_PROPERTY("NestHandleScopes", NestHandleScopes),
   };
 
   NAPI_CALL(env, napi_define_properties(
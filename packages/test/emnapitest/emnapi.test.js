@@ -44,4 +44,62 @@ module.exports = promise.then(test_typedarray => {
     assert.strictEqual(typeof patch, 'number')
     console.log(`test: Emscripten v${major}.${minor}.${patch}`)
   }
+
+  const LazyClass = test_typedarray.DefineLazyClass()
+  const lazy = new LazyClass()
+  assert.strictEqual(lazy.one(), 1)
+  assert.strictEqual(lazy.one, LazyClass.prototype.one)
+  const oneDescriptor = Object.getOwnPropertyDescriptor(LazyClass.prototype, 'one')
+  assert.strictEqual(typeof oneDescriptor.value, 'function')
+  assert.strictEqual(oneDescriptor.writable, true)
+  assert.strictEqual(oneDescriptor.enumerable, false)
+  assert.strictEqual(oneDescriptor.configurable, true)
+  lazy.two = 42
+  assert.strictEqual(lazy.two, 42)
+  assert.strictEqual(new LazyClass().two(), 2)
+  assert.strictEqual(LazyClass.three(), 3)
+
+  // frozen before the first read, the accessor stays and keeps returning one function
+  const FrozenLazyClass = test_typedarray.DefineLazyClass()
+  Object.freeze(FrozenLazyClass)
+  Object.freeze(FrozenLazyClass.prototype)
+  const frozenLazy = new FrozenLazyClass()
+  assert.strictEqual(frozenLazy.one(), 1)
+  assert.strictEqual(frozenLazy.two(), 2)
+  assert.strictEqual(FrozenLazyClass.three(), 3)
+  assert.strictEqual(frozenLazy.one, FrozenLazyClass.prototype.one)
+  assert.strictEqual(FrozenLazyClass.three, FrozenLazyClass.three)
+  const frozenDescriptor = Object.getOwnPropertyDescriptor(FrozenLazyClass.prototype, 'one')
+  assert.strictEqual(typeof frozenDescriptor.get, 'function')
+  assert.strictEqual(frozenDescriptor.enumerable, false)
+  assert.strictEqual(frozenDescriptor.configurable, false)
+  assert.ok(Object.isFrozen(FrozenLazyClass.prototype))
+
+  const stats = test_typedarray.GetRuntimeStats()
+  assert.strictEqual(stats.scope_depth, 1)
+  assert.ok(stats.peak_scope_depth >= 1)
+  assert.ok(stats.peak_handle_count >= stats.handle_count)
+
+  const leaked = test_typedarray.LeakHandles(100)
+  assert.ok(leaked.handle_count >= stats.handle_count + 100)
+  assert.ok(leaked.peak_handle_count >= leaked.handle_count)
+  assert.ok(test_typedarray.GetRuntimeStats().peak_handle_count >= leaked.handle_count)
+
+  // capacity above the ceiling is trimmed as soon as all scopes are closed
+  const deep = test_typedarray.NestHandleScopes(64, 1100)
+  assert.strictEqual(deep.scope_depth, stats.scope_depth + 64)
+  assert.ok(deep.handle_count >= 64 * 1100)
+  assert.ok(deep.handle_capacity > 65536)
+  const trimmed = test_typedarray.GetRuntimeStats()
+  assert.strictEqual(trimmed.scope_depth, stats.scope_depth)
+  assert.ok(trimmed.handle_capacity < 65536)
+  assert.ok(trimmed.handle_capacity >= trimmed.handle_count)
+
+  // below the ceiling it is kept until 16 top level calls in a row use under a quarter of it
+  const grown = test_typedarray.NestHandleScopes(16, 1000).handle_capacity
+  assert.ok(grown >= 16 * 1000)
+  for (let i = 0; i < 16; i++) {
+    assert.strictEqual(test_typedarray.GetRuntimeStats().handle_capacity, grown)
+  }
+  assert.ok(test_typedarray.GetRuntimeStats().handle_capacity < grown / 2)
 })
@@ -2,6 +2,11 @@
 #include <js_native_api.h>
 #include "../common.h"
 
+#ifdef __wasm__
+void* malloc(size_t size);
+void free(void* p);
+#endif
+
 static napi_value checkError(napi_env env, napi_callback_info info) {
   size_t argc = 1;
   napi_value args[1];
@@ -168,6 +173,46 @@ static napi_value throwArbitrary(napi_env env, napi_callback_info info) {
   return NULL;
 }
 
+#ifdef __wasm__
+// mallocs 16MB chunks until the memory has grown
+static bool growMemory(void) {
+  size_t pages = __builtin_wasm_memory_size(0);
+  void* chunks[128];
+  size_t count = 0, i;
+  while (count < 128 && __builtin_wasm_memory_size(0) == pages) {
+    chunks[count] = malloc(16 * 1024 * 1024);
+    if (chunks[count] == NULL) break;
+    count++;
+  }
+  for (i = 0; i < count; i++) free(chunks[i]);
+  return __builtin_wasm_memory_size(0) != pages;
+}
+
+// the last error is written from JS and read from C without an API call
+// in between, so it has to land in the grown memory
+static napi_value lastErrorAfterGrowMemory(napi_env env, napi_callback_info info) {
+  const napi_extended_error_info* error_info;
+  napi_value result;
+  NAPI_CALL(env, napi_get_last_error_info(env, &error_info));
+
+  NAPI_ASSERT(env, growMemory(), "Memory did not grow");
+  // napi_throw touches no memory itself, only the last error
+  NAPI_ASSERT(env, napi_throw(env, NULL) == napi_invalid_arg,
+      "napi_throw should reject a NULL error");
+  NAPI_ASSERT(env, error_info->error_code == napi_invalid_arg,
+      "Last error should be napi_invalid_arg after growing memory");
+
+  NAPI_ASSERT(env, growMemory(), "Memory did not grow");
+  NAPI_CALL(env, napi_get_boolean(env, true, &result));
+  NAPI_CALL(env, napi_throw(env, result));
+  napi_status cleared = error_info->error_code;
+  NAPI_CALL(env, napi_get_and_clear_last_exception(env, &result));
+  NAPI_ASSERT(env, cleared == napi_ok,
+      "Last error should be cleared after growing memory");
+  return result;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor descriptors[] = {
@@ -190,6 +235,9 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("createRangeErrorCode", createRangeErrorCode),
     DECLARE_NAPI_PROPERTY("createTypeErrorCode", createTypeErrorCode),
     DECLARE_NAPI_PROPERTY("createSyntaxErrorCode", createSyntaxErrorCode),
+#ifdef __wasm__
+    DECLARE_NAPI_PROPERTY("lastErrorAfterGrowMemory", lastErrorAfterGrowMemory),
+#endif
   };
 
   NAPI_CALL(env, napi_define_properties(
@@ -147,4 +147,8 @@ module.exports = promise.then(test_error => {
   assert.strictEqual(error.message, 'SyntaxError [syntax error]')
   assert.strictEqual(error.code, 'ERR_TEST_CODE')
   assert.strictEqual(error.name, 'SyntaxError')
+
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    assert.strictEqual(test_error.lastErrorAfterGrowMemory(), true)
+  }
 })
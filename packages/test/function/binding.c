@@ -1,4 +1,7 @@
 #include <js_native_api.h>
+#ifdef __wasm__
+#include <emnapi.h>
+#endif
 #include "../common.h"
 
 static napi_value TestCreateFunctionParameters(napi_env env,
@@ -164,6 +167,32 @@ static napi_value TestCreateFunctionKeyword(napi_env env, napi_callback_info inf
   return result;
 }
 
+#ifdef __wasm__
+static double TypedMulAdd(int32_t a, double b, double c) {
+  return a * b + c;
+}
+
+static uint32_t TypedAddData(void* data, uint32_t a) {
+  return *(uint32_t*) data + a;
+}
+
+static napi_value CreateTypedFunctions(napi_env env, napi_callback_info info) {
+  static uint32_t base = 0xFFFFFFF0;
+  napi_value result, fn;
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+  NAPI_CALL(env, emnapi_create_function_typed(
+      env, "mulAdd", "d(idd)", (emnapi_typed_callback) TypedMulAdd, NULL, &fn));
+  NAPI_CALL(env, napi_set_named_property(env, result, "mulAdd", fn));
+
+  NAPI_CALL(env, emnapi_create_function_typed(
+      env, NULL, "u(pu)", (emnapi_typed_callback) TypedAddData, &base, &fn));
+  NAPI_CALL(env, napi_set_named_property(env, result, "addData", fn));
+
+  return result;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_value fn1;
@@ -220,6 +249,20 @@ napi_value Init(napi_env env, napi_value exports) {
                                          "TestCreateFunctionKeyword",
                                          fn6));
 
+#ifdef __wasm__
+  napi_value fn7;
+  NAPI_CALL(env, napi_create_function(env,
+                                      "TestCreateTypedFunctions",
+                                      NAPI_AUTO_LENGTH,
+                                      CreateTypedFunctions,
+                                      NULL,
+                                      &fn7));
+  NAPI_CALL(env, napi_set_named_property(env,
+                                         exports,
+                                         "TestCreateTypedFunctions",
+                                         fn7));
+#endif
+
   return exports;
 }
 EXTERN_C_END
@@ -45,4 +45,12 @@ module.exports = load('function').then(async test_function => {
   })
 
   assert.strictEqual(test_function.TestCreateFunctionKeyword().name, 'catch')
+
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    const typed = test_function.TestCreateTypedFunctions()
+    assert.strictEqual(typed.mulAdd.name, 'mulAdd')
+    assert.strictEqual(typed.mulAdd(3, 0.5, 1), 2.5)
+    assert.strictEqual(typed.mulAdd(3.9, 2, 0), 6)
+    assert.strictEqual(typed.addData(1), 0xFFFFFFF1)
+  }
 })
@@ -131,6 +131,65 @@ static napi_value testNapiTypeof(napi_env env, napi_callback_info info) {
   return result;
 }
 
+static napi_value testTypeofReusedSlot(napi_env env, napi_callback_info info) {
+  napi_handle_scope scope;
+  napi_value array, number;
+  napi_valuetype type;
+  bool is_array;
+
+  // an array released with its scope must not leak its type into the
+  // next value created in the same slot
+  NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+  NAPI_CALL(env, napi_create_array(env, &array));
+  NAPI_CALL(env, napi_is_array(env, array, &is_array));
+  NAPI_ASSERT(env, is_array, "array is an array");
+  NAPI_CALL(env, napi_close_handle_scope(env, scope));
+
+  NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+  NAPI_CALL(env, napi_create_double(env, 1, &number));
+  NAPI_CALL(env, napi_is_array(env, number, &is_array));
+  NAPI_ASSERT(env, !is_array, "number in a reused slot is not an array");
+  NAPI_CALL(env, napi_typeof(env, number, &type));
+  NAPI_ASSERT(env, type == napi_number, "number in a reused slot is a number");
+  NAPI_CALL(env, napi_close_handle_scope(env, scope));
+
+  // enough handles to outgrow any table sized at startup
+  NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+  for (int i = 0; i < 3000; i++) {
+    NAPI_CALL(env, napi_create_int32(env, i, &number));
+  }
+  NAPI_CALL(env, napi_typeof(env, number, &type));
+  NAPI_ASSERT(env, type == napi_number, "late handle is a number");
+  NAPI_CALL(env, napi_create_array(env, &array));
+  NAPI_CALL(env, napi_is_array(env, array, &is_array));
+  NAPI_ASSERT(env, is_array, "late handle is an array");
+  NAPI_CALL(env, napi_typeof(env, array, &type));
+  NAPI_ASSERT(env, type == napi_object, "late array is an object");
+  NAPI_CALL(env, napi_close_handle_scope(env, scope));
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_boolean(env, true, &result));
+  return result;
+}
+
+static napi_value testIsArrayLike(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  bool is_array, is_typedarray;
+  NAPI_CALL(env, napi_is_array(env, args[0], &is_array));
+  NAPI_CALL(env, napi_is_typedarray(env, args[0], &is_typedarray));
+
+  napi_value result, value;
+  NAPI_CALL(env, napi_create_array_with_length(env, 2, &result));
+  NAPI_CALL(env, napi_get_boolean(env, is_array, &value));
+  NAPI_CALL(env, napi_set_element(env, result, 0, value));
+  NAPI_CALL(env, napi_get_boolean(env, is_typedarray, &value));
+  NAPI_CALL(env, napi_set_element(env, result, 1, value));
+  return result;
+}
+
 static bool deref_item_called = false;
 static void deref_item(napi_env env, void* data, void* hint) {
   (void) hint;
@@ -313,6 +372,8 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("createNapiError", createNapiError),
     DECLARE_NAPI_PROPERTY("testNapiErrorCleanup", testNapiErrorCleanup),
     DECLARE_NAPI_PROPERTY("testNapiTypeof", testNapiTypeof),
+    DECLARE_NAPI_PROPERTY("testTypeofReusedSlot", testTypeofReusedSlot),
+    DECLARE_NAPI_PROPERTY("testIsArrayLike", testIsArrayLike),
     DECLARE_NAPI_PROPERTY("wrap", wrap),
     DECLARE_NAPI_PROPERTY("envCleanupWrap", env_cleanup_wrap),
     DECLARE_NAPI_PROPERTY("unwrap", unwrap),
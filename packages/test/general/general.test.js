@@ -58,6 +58,25 @@ module.exports = load('general').then(async test_general => {
   // for null
   assert.strictEqual(test_general.testNapiTypeof(null), 'null')
 
+  assert.strictEqual(test_general.testTypeofReusedSlot(), true)
+
+  assert.deepStrictEqual(test_general.testIsArrayLike([]), [true, false])
+  assert.deepStrictEqual(test_general.testIsArrayLike(new Uint8Array(1)), [false, true])
+  assert.deepStrictEqual(test_general.testIsArrayLike({}), [false, false])
+
+  // checking a proxy must not run any of its traps
+  let trapCalls = 0
+  const trap = () => { trapCalls++; throw new Error('trap') }
+  const proxy = new Proxy({}, {
+    get: trap,
+    has: trap,
+    getPrototypeOf: trap,
+    getOwnPropertyDescriptor: trap,
+    ownKeys: trap
+  })
+  assert.deepStrictEqual(test_general.testIsArrayLike(proxy), [false, false])
+  assert.strictEqual(trapCalls, 0)
+
   // Assert that wrapping twice fails.
   const x = {}
   test_general.wrap(x)
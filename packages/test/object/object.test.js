@@ -392,4 +392,26 @@ module.exports = load('object').then(test_object => {
       delete obj.x
     }, /Cannot delete property 'x' of #<Object>/)
   }
+
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    assert.deepStrictEqual(test_object.CreateValues(), [-1, 4294967295, 0.5, true, 'hello', 'hello world'])
+
+    const structObject = test_object.CreateStructObject()
+    assert.deepStrictEqual(Object.keys(structObject), ['x', 'y'])
+    assert.strictEqual(structObject.x, -3)
+    assert.strictEqual(structObject.y, 0.25)
+    assert.strictEqual(structObject.flag, false)
+    structObject.x = 7
+    structObject.flag = 1
+    assert.strictEqual(structObject.x, 7)
+    assert.strictEqual(structObject.flag, true)
+    assert.throws(() => { structObject.y = 1 }, TypeError)
+    assert.throws(() => Object.getOwnPropertyDescriptor(structObject, 'x').get.call({}), TypeError)
+
+    // packed fields are rejected up front, misaligned wrapped pointers on access
+    assert.strictEqual(test_object.DefinePackedStructField(), true)
+    const misaligned = test_object.CreateMisalignedStructObject()
+    assert.throws(() => misaligned.value, RangeError)
+    assert.throws(() => { misaligned.value = 1 }, RangeError)
+  }
 })
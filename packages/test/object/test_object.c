@@ -1,4 +1,8 @@
 #define NAPI_EXPERIMENTAL
+#ifdef __wasm__
+#include <stddef.h>
+#include <emnapi.h>
+#endif
 #include <js_native_api.h>
 #include "../common.h"
 // #include <string.h>
@@ -691,6 +695,90 @@ CheckTypeTag(napi_env env, napi_callback_info info) {
   return js_result;
 }
 
+#ifdef __wasm__
+static napi_value CreateValues(napi_env env, napi_callback_info info) {
+  static const char str[] = "hello world";
+  emnapi_value_descriptor descriptors[6];
+  napi_value values[6];
+  napi_value result;
+  size_t i;
+
+  descriptors[0].type = emnapi_value_int32;
+  descriptors[0].value.int32 = -1;
+  descriptors[1].type = emnapi_value_uint32;
+  descriptors[1].value.uint32 = 0xFFFFFFFF;
+  descriptors[2].type = emnapi_value_double;
+  descriptors[2].value.number = 0.5;
+  descriptors[3].type = emnapi_value_bool;
+  descriptors[3].value.boolean = true;
+  descriptors[4].type = emnapi_value_string_utf8;
+  descriptors[4].value.utf8.str = str;
+  descriptors[4].value.utf8.length = 5;
+  descriptors[5].type = emnapi_value_string_utf8;
+  descriptors[5].value.utf8.str = str;
+  descriptors[5].value.utf8.length = NAPI_AUTO_LENGTH;
+
+  NAPI_CALL(env, emnapi_create_values(env, 6, descriptors, values));
+
+  napi_value true_value;
+  NAPI_CALL(env, napi_get_boolean(env, true, &true_value));
+  NAPI_ASSERT(env, values[3] == true_value,
+      "Booleans should share the handle napi_get_boolean returns");
+
+  NAPI_CALL(env, napi_create_array_with_length(env, 6, &result));
+  for (i = 0; i < 6; i++) {
+    NAPI_CALL(env, napi_set_element(env, result, (uint32_t) i, values[i]));
+  }
+  return result;
+}
+
+typedef struct {
+  int32_t x;
+  double y;
+  bool flag;
+} StructFields;
+
+static napi_value CreateStructObject(napi_env env, napi_callback_info info) {
+  static StructFields fields = { -3, 0.25, false };
+  emnapi_field_descriptor descriptors[] = {
+    { "x", offsetof(StructFields, x), emnapi_field_int32, napi_writable | napi_enumerable },
+    { "y", offsetof(StructFields, y), emnapi_field_double, napi_enumerable },
+    { "flag", offsetof(StructFields, flag), emnapi_field_bool, napi_writable },
+  };
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, napi_wrap(env, result, &fields, NULL, NULL, NULL));
+  NAPI_CALL(env, emnapi_define_struct_accessors(env, result,
+      sizeof(descriptors) / sizeof(*descriptors), descriptors));
+  return result;
+}
+
+static napi_value DefinePackedStructField(napi_env env,
+                                          napi_callback_info info) {
+  // an int32 right after a char in a packed struct
+  emnapi_field_descriptor descriptor =
+      { "packed", 1, emnapi_field_int32, napi_writable };
+  napi_value object, result;
+  napi_status status;
+  NAPI_CALL(env, napi_create_object(env, &object));
+  status = emnapi_define_struct_accessors(env, object, 1, &descriptor);
+  NAPI_CALL(env, napi_get_boolean(env, status == napi_invalid_arg, &result));
+  return result;
+}
+
+static napi_value CreateMisalignedStructObject(napi_env env,
+                                               napi_callback_info info) {
+  static double storage[2];
+  emnapi_field_descriptor descriptor =
+      { "value", 0, emnapi_field_int32, napi_writable };
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, napi_wrap(env, result, (char*) storage + 1, NULL, NULL, NULL));
+  NAPI_CALL(env, emnapi_define_struct_accessors(env, result, 1, &descriptor));
+  return result;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor descriptors[] = {
@@ -724,6 +812,12 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("TestGetProperty", TestGetProperty),
     DECLARE_NAPI_PROPERTY("TestFreeze", TestFreeze),
     DECLARE_NAPI_PROPERTY("TestSeal", TestSeal),
+#ifdef __wasm__
+    DECLARE_NAPI_PROPERTY("CreateValues", CreateValues),
+    DECLARE_NAPI_PROPERTY("CreateStructObject", CreateStructObject),
+    DECLARE_NAPI_PROPERTY("DefinePackedStructField", DefinePackedStructField),
+    DECLARE_NAPI_PROPERTY("CreateMisalignedStructObject", CreateMisalignedStructObject),
+#endif
   };
 
   init_test_null(env, exports);
@@ -47,12 +47,39 @@ static napi_value isPromise(napi_env env, napi_callback_info info) {
   return result;
 }
 
+#ifdef __wasm__
+// ids of concluded deferreds are never reused as is, even when the slot is
+static napi_value checkStaleDeferred(napi_env env, napi_callback_info info) {
+  napi_deferred stale, fresh;
+  napi_value stale_promise, fresh_promise, undefined;
+
+  NAPI_CALL(env, napi_get_undefined(env, &undefined));
+  NAPI_CALL(env, napi_create_promise(env, &stale, &stale_promise));
+  NAPI_CALL(env, napi_resolve_deferred(env, stale, undefined));
+  NAPI_CALL(env, napi_create_promise(env, &fresh, &fresh_promise));
+  NAPI_ASSERT(env, fresh != stale, "A new deferred should get a new id.");
+
+  NAPI_ASSERT(env,
+      napi_resolve_deferred(env, stale, undefined) == napi_invalid_arg,
+      "napi_resolve_deferred should reject a concluded deferred.");
+  NAPI_ASSERT(env,
+      napi_reject_deferred(env, stale, undefined) == napi_invalid_arg,
+      "napi_reject_deferred should reject a concluded deferred.");
+
+  NAPI_CALL(env, napi_resolve_deferred(env, fresh, stale_promise));
+  return fresh_promise;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor descriptors[] = {
     DECLARE_NAPI_PROPERTY("createPromise", createPromise),
     DECLARE_NAPI_PROPERTY("concludeCurrentPromise", concludeCurrentPromise),
     DECLARE_NAPI_PROPERTY("isPromise", isPromise),
+#ifdef __wasm__
+    DECLARE_NAPI_PROPERTY("checkStaleDeferred", checkStaleDeferred),
+#endif
   };
 
   NAPI_CALL(env, napi_define_properties(
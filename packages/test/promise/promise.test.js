@@ -63,4 +63,8 @@ module.exports = load('promise').then(async test_promise => {
   assert.strictEqual(test_promise.isPromise(undefined), false)
   assert.strictEqual(test_promise.isPromise(null), false)
   assert.strictEqual(test_promise.isPromise({}), false)
+
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    assert.strictEqual(await test_promise.checkStaleDeferred(), undefined)
+  }
 })
@@ -1,5 +1,8 @@
 #define NAPI_VERSION 9
 #include <js_native_api.h>
+#ifdef __wasm__
+#include <emnapi.h>
+#endif
 #include "../common.h"
 
 static double value_ = 1;
@@ -60,6 +63,82 @@ static napi_value HasNamedProperty(napi_env env, napi_callback_info info) {
   return result;
 }
 
+#ifdef __wasm__
+static napi_value SwapNamedProperties(napi_env env, napi_callback_info info) {
+  static const char* keys[] = { "a", "b", "c" };
+  static const char* swapped_keys[] = { "c", "b", "a" };
+  size_t argc = 1;
+  napi_value args[1];
+  napi_value values[3];
+  napi_value result;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 1, "Wrong number of arguments");
+
+  NAPI_CALL(env, emnapi_get_named_properties(env, args[0], 3, keys, values));
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, emnapi_set_named_properties(env, result, 3, swapped_keys, values));
+  return result;
+}
+
+static const char key_pool[] = "foo\0bar";
+
+static napi_value GetCachedKeys(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_value key1, key2, result, value;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 1, "Wrong number of arguments");
+
+  NAPI_CALL(env, emnapi_enable_property_key_cache(env, key_pool, sizeof(key_pool)));
+
+  NAPI_CALL(env, emnapi_create_property_key_utf8(env, key_pool + 4, NAPI_AUTO_LENGTH, &key1));
+  NAPI_CALL(env, emnapi_create_property_key_utf8(env, key_pool + 4, 3, &key2));
+  NAPI_ASSERT(env, key1 == key2, "Interned keys should share one handle");
+
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, napi_get_named_property(env, args[0], key_pool, &value));
+  NAPI_CALL(env, napi_set_named_property(env, result, key_pool, value));
+  NAPI_CALL(env, napi_get_named_property(env, args[0], key_pool, &value));
+  NAPI_CALL(env, napi_set_property(env, result, key1, value));
+
+  NAPI_CALL(env, emnapi_enable_property_key_cache(env, NULL, 0));
+  return result;
+}
+
+// interns keys "0", "1", ... which are outside of the key cache range
+static napi_value InternKeys(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  uint32_t count, i, n;
+  char name[16];
+  size_t length;
+  napi_value key;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 1, "Wrong number of arguments");
+  NAPI_CALL(env, napi_get_value_uint32(env, args[0], &count));
+
+  for (i = 0; i < count; i++) {
+    length = sizeof(name);
+    n = i;
+    do {
+      name[--length] = (char) ('0' + n % 10);
+      n /= 10;
+    } while (n != 0);
+    NAPI_CALL(env, emnapi_create_property_key_utf8(
+        env, name + length, sizeof(name) - length, &key));
+  }
+  return NULL;
+}
+
+static napi_value GetPersistentHandleCount(napi_env env, napi_callback_info info) {
+  emnapi_runtime_stats stats;
+  napi_value result;
+  NAPI_CALL(env, emnapi_get_runtime_stats(env, &stats));
+  NAPI_CALL(env, napi_create_uint32(env, stats.persistent_handle_count, &result));
+  return result;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_value number;
@@ -105,6 +184,12 @@ napi_value Init(napi_env env, napi_value exports) {
     { "readonlyAccessor1", 0, 0, GetValue, NULL, 0, napi_default, 0},
     { "readonlyAccessor2", 0, 0, GetValue, NULL, 0, napi_writable, 0},
     { "hasNamedProperty", 0, HasNamedProperty, 0, 0, 0, napi_default, 0 },
+#ifdef __wasm__
+    { "swapNamedProperties", 0, SwapNamedProperties, 0, 0, 0, napi_default, 0 },
+    { "getCachedKeys", 0, GetCachedKeys, 0, 0, 0, napi_default, 0 },
+    { "internKeys", 0, InternKeys, 0, 0, 0, napi_default, 0 },
+    { "persistentHandleCount", 0, 0, GetPersistentHandleCount, 0, 0, napi_default, 0 },
+#endif
   };
 
   NAPI_CALL(env, napi_define_properties(
@@ -65,4 +65,20 @@ module.exports = load('property').then(test_object => {
     true)
   assert.strictEqual(test_object.hasNamedProperty(test_object, 'doesnotexist'),
     false)
+
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    assert.deepStrictEqual(test_object.swapNamedProperties({ a: 1, b: 'x', c: null }), { c: 1, b: 'x', a: null })
+    assert.deepStrictEqual(test_object.swapNamedProperties({ a: 1 }), { c: 1, b: undefined, a: undefined })
+
+    // resetting the key cache releases the interned keys
+    const persistentHandleCount = test_object.persistentHandleCount
+    assert.deepStrictEqual(test_object.getCachedKeys({ foo: 42 }), { foo: 42, bar: 42 })
+    assert.strictEqual(test_object.persistentHandleCount, persistentHandleCount)
+
+    // at most 4096 keys are interned, the oldest ones are released first
+    test_object.internKeys(5000)
+    assert.strictEqual(test_object.persistentHandleCount, persistentHandleCount + 4096)
+    test_object.internKeys(5000)
+    assert.strictEqual(test_object.persistentHandleCount, persistentHandleCount + 4096)
+  }
 })
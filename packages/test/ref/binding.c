@@ -258,6 +258,74 @@ static napi_value ValidateDeleteBeforeFinalize(napi_env env, napi_callback_info
   return wrapObject;
 }
 
+#ifdef __wasm__
+#include <emnapi.h>
+
+static napi_value GetPersistentHandleCount(napi_env env, napi_callback_info info) {
+  emnapi_runtime_stats stats;
+  NAPI_CALL(env, emnapi_get_runtime_stats(env, &stats));
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_uint32(env, stats.persistent_handle_count, &result));
+  return result;
+}
+
+// ids of deleted references are never reused as is, even when the slot is
+static napi_value CheckStaleReference(napi_env env, napi_callback_info info) {
+  napi_value object;
+  NAPI_CALL(env, napi_create_object(env, &object));
+
+  napi_ref stale;
+  NAPI_CALL(env, napi_create_reference(env, object, 1, &stale));
+  NAPI_CALL(env, napi_delete_reference(env, stale));
+
+  napi_ref fresh;
+  NAPI_CALL(env, napi_create_reference(env, object, 1, &fresh));
+  NAPI_ASSERT(env, fresh != stale, "A new reference should get a new id.");
+
+  napi_value value;
+  uint32_t refcount;
+  NAPI_ASSERT(env,
+      napi_get_reference_value(env, stale, &value) == napi_invalid_arg,
+      "napi_get_reference_value should reject a deleted reference.");
+  NAPI_ASSERT(env,
+      napi_reference_ref(env, stale, &refcount) == napi_invalid_arg,
+      "napi_reference_ref should reject a deleted reference.");
+  NAPI_ASSERT(env,
+      napi_reference_unref(env, stale, &refcount) == napi_invalid_arg,
+      "napi_reference_unref should reject a deleted reference.");
+  NAPI_ASSERT(env,
+      napi_delete_reference(env, stale) == napi_invalid_arg,
+      "napi_delete_reference should reject a deleted reference.");
+
+  NAPI_CALL(env, napi_get_reference_value(env, fresh, &value));
+  NAPI_CALL(env, napi_reference_ref(env, fresh, &refcount));
+  NAPI_ASSERT(env, refcount == 2, "The new reference should be untouched.");
+  NAPI_CALL(env, napi_delete_reference(env, fresh));
+  return value;
+}
+
+static napi_value GetReferenceHandle(napi_env env, napi_callback_info info) {
+  NAPI_ASSERT(env, test_reference != NULL,
+      "A reference must have been created.");
+
+  napi_value value;
+  NAPI_CALL(env, napi_get_reference_value(env, test_reference, &value));
+
+  napi_value inner;
+  napi_handle_scope scope;
+  NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+  NAPI_CALL(env, napi_get_reference_value(env, test_reference, &inner));
+  NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  NAPI_ASSERT(env, inner == value,
+      "A strong reference should hand out the same handle in nested scopes.");
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_double(env, (double) (uintptr_t) value, &result));
+  return result;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor descriptors[] = {
@@ -279,6 +347,11 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_GETTER("referenceValue", GetReferenceValue),
     DECLARE_NAPI_PROPERTY("validateDeleteBeforeFinalize",
                           ValidateDeleteBeforeFinalize),
+#ifdef __wasm__
+    DECLARE_NAPI_GETTER("persistentHandleCount", GetPersistentHandleCount),
+    DECLARE_NAPI_GETTER("referenceHandle", GetReferenceHandle),
+    DECLARE_NAPI_PROPERTY("checkStaleReference", CheckStaleReference),
+#endif
   };
 
   NAPI_CALL(env, napi_define_properties(
@@ -16,6 +16,45 @@ module.exports = p.then(test_reference => {
   // Run each test function in sequence,
   // with an async delay and GC call between each.
   async function runTests () {
+    if (!process.env.EMNAPI_TEST_NATIVE) {
+      // strong references own one persistent handle, stable across scopes
+      const persistentHandleCount = test_reference.persistentHandleCount
+      const object = {}
+      test_reference.createReference(object, 1)
+      const handle = test_reference.referenceHandle
+      assert.strictEqual(test_reference.referenceHandle, handle)
+      assert.strictEqual(test_reference.referenceValue, object)
+      assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount + 1)
+
+      // released when the refcount drops to 0
+      assert.strictEqual(test_reference.decrementRefcount(), 0)
+      assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount)
+      assert.strictEqual(test_reference.referenceValue, object)
+      assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount)
+
+      // taken again once strong, and released when the reference is deleted
+      assert.strictEqual(test_reference.incrementRefcount(), 1)
+      test_reference.referenceHandle // eslint-disable-line no-unused-expressions
+      assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount + 1)
+      test_reference.deleteReference()
+      assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount)
+
+      // released before a weak reference is finalized
+      ;(() => {
+        const value = test_reference.createExternalWithFinalize()
+        test_reference.createReference(value, 1)
+        test_reference.referenceHandle // eslint-disable-line no-unused-expressions
+        assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount + 1)
+        assert.strictEqual(test_reference.decrementRefcount(), 0)
+      })()
+      await gcUntil('Persistent handle of a finalized reference',
+        () => (test_reference.finalizeCount === 1))
+      assert.strictEqual(test_reference.persistentHandleCount, persistentHandleCount)
+      test_reference.deleteReference()
+
+      assert.strictEqual(typeof test_reference.checkStaleReference(), 'object')
+    }
+
     // https://github.com/tc39/proposal-symbols-as-weakmap-keys
     (() => {
       const symbol = test_reference.createSymbol('testSym')
@@ -31,6 +31,9 @@ void abort() {
 
 #define NAPI_EXPERIMENTAL
 #include <js_native_api.h>
+#ifdef __wasm__
+#include <emnapi.h>
+#endif
 #include "../common.h"
 #include "test_null.h"
 
@@ -137,7 +140,7 @@ static napi_status create_external_latin1(napi_env env,
   status = node_api_create_external_string_latin1(
       env, string_copy, length, free_string, NULL, result, &copied);
   // We do not want the string to be copied.
-  if (!copied) {
+  if (copied) {
     return napi_generic_failure;
   }
   if (status != napi_ok) {
@@ -176,6 +179,12 @@ static napi_status create_external_utf16(napi_env env,
 
   status = node_api_create_external_string_utf16(
       env, string_copy, length, free_string, NULL, result, &copied);
+#ifdef __wasm__
+  // emnapi keeps the buffer for utf16 too
+  if (copied) {
+    return napi_generic_failure;
+  }
+#endif
   if (status != napi_ok) {
     free(string_copy);
     return status;
@@ -436,6 +445,164 @@ static napi_value TestUtf16Large(napi_env env, napi_callback_info info) {
   return output;
 }
 
+// the length queried for a handle must not be used by the next string
+// that lands in the same slot after its scope is closed
+static napi_value TestLengthAfterScopeClose(napi_env env,
+                                            napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_handle_scope scope;
+  napi_value str, result;
+  size_t length, copied;
+  char* buf;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 2, "Wrong number of arguments");
+
+  NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &length));
+  buf = (char*) malloc(length + 1);
+  NAPI_ASSERT(env, buf != NULL, "Out of memory");
+
+  NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+  NAPI_CALL(env, napi_coerce_to_string(env, args[0], &str));
+  NAPI_CALL(env, napi_get_value_string_utf8(env, str, NULL, 0, &copied));
+  NAPI_CALL(env, napi_close_handle_scope(env, scope));
+
+  NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+  NAPI_CALL(env, napi_coerce_to_string(env, args[1], &str));
+  NAPI_CALL(env, napi_get_value_string_utf8(env, str, buf, length + 1, &copied));
+  NAPI_CALL(env, napi_close_handle_scope(env, scope));
+
+  NAPI_ASSERT(env, copied == length, "Copy does not match the length query");
+  NAPI_CALL(env, napi_create_string_utf8(env, buf, copied, &result));
+  free(buf);
+  return result;
+}
+
+#ifdef __wasm__
+// allocates until malloc has to grow the memory, so the JS views go stale
+static bool GrowMemoryFromC(void) {
+  size_t pages = __builtin_wasm_memory_size(0);
+  void* chunks[128];
+  size_t count = 0, i;
+  while (count < 128 && __builtin_wasm_memory_size(0) == pages) {
+    chunks[count] = malloc(16 * 1024 * 1024);
+    if (chunks[count] == NULL) break;
+    count++;
+  }
+  for (i = 0; i < count; i++) free(chunks[i]);
+  return __builtin_wasm_memory_size(0) != pages;
+}
+
+static napi_value TestAfterGrowMemory(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  char buf[64];
+  size_t copied;
+  napi_value result;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 1, "Wrong number of arguments");
+
+  NAPI_ASSERT(env, GrowMemoryFromC(), "Memory did not grow");
+  NAPI_CALL(env, napi_get_value_string_utf8(env, args[0], buf, sizeof(buf), &copied));
+  NAPI_CALL(env, napi_create_string_utf8(env, buf, copied, &result));
+  return result;
+}
+
+static napi_value CopyStrings(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_value result, value;
+  char* buf;
+  size_t length, copied;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc >= 1, "Wrong number of arguments");
+  NAPI_CALL(env, napi_create_array_with_length(env, 2, &result));
+
+  NAPI_CALL(env, emnapi_get_value_string_utf8_alloc(env, args[0], &buf, &length));
+  NAPI_ASSERT(env, buf[length] == '\0', "Not null terminated");
+  NAPI_CALL(env, napi_create_string_utf8(env, buf, length, &value));
+  free(buf);
+  NAPI_CALL(env, napi_set_element(env, result, 0, value));
+
+  NAPI_CALL(env, napi_get_value_string_utf8(env, args[0], NULL, 0, &length));
+  buf = (char*) malloc(length + 1);
+  NAPI_CALL(env, napi_get_value_string_utf8(env, args[0], buf, length + 1, &copied));
+  NAPI_ASSERT(env, copied == length, "Length query does not match copy");
+  NAPI_CALL(env, napi_create_string_utf8(env, buf, copied, &value));
+  free(buf);
+  NAPI_CALL(env, napi_set_element(env, result, 1, value));
+
+  return result;
+}
+static int external_finalize_count = 0;
+
+static void count_external_finalize(napi_env env, void* data, void* hint) {
+  external_finalize_count++;
+}
+
+static napi_value TestExternalStringCache(napi_env env,
+                                          napi_callback_info info) {
+  static const char name[] = "cached external";
+  // emnapi keeps at most 1 MiB of external string buffers per env
+  const size_t budget = 1 << 20;
+  char reused[] = "reused address";
+  char* large;
+  napi_value first, second, value, result;
+  bool copied = true, equals = false;
+  external_finalize_count = 0;
+
+  // miss: the buffer is kept, not copied and not finalized
+  NAPI_CALL(env, node_api_create_external_string_latin1(
+      env, (char*) name, sizeof(name) - 1,
+      count_external_finalize, NULL, &first, &copied));
+  NAPI_ASSERT(env, !copied, "Miss copied the buffer");
+  NAPI_ASSERT(env, external_finalize_count == 0, "Miss ran the finalizer");
+
+  // hit: the cached string is returned and the finalizer is deferred too
+  copied = true;
+  NAPI_CALL(env, node_api_create_external_string_latin1(
+      env, (char*) name, sizeof(name) - 1,
+      count_external_finalize, NULL, &second, &copied));
+  NAPI_ASSERT(env, !copied, "Hit copied the buffer");
+  NAPI_ASSERT(env, external_finalize_count == 0, "Hit ran the finalizer");
+  NAPI_CALL(env, napi_strict_equals(env, first, second, &equals));
+  NAPI_ASSERT(env, equals, "Hit returned a different string");
+
+  // same address and length with other contents is not a hit
+  NAPI_CALL(env, node_api_create_external_string_latin1(
+      env, reused, sizeof(reused) - 1, NULL, NULL, &first, &copied));
+  reused[0] = 'R';
+  NAPI_CALL(env, node_api_create_external_string_latin1(
+      env, reused, sizeof(reused) - 1, NULL, NULL, &second, &copied));
+  NAPI_CALL(env, napi_strict_equals(env, first, second, &equals));
+  NAPI_ASSERT(env, !equals, "Hit ignored changed contents");
+
+  large = malloc(budget + 1);
+  NAPI_ASSERT(env, large != NULL, "Failed to allocate memory");
+  memset(large, 'a', budget + 1);
+
+  // a buffer over the budget is copied and finalized right away
+  copied = false;
+  NAPI_CALL(env, node_api_create_external_string_latin1(
+      env, large, budget + 1,
+      count_external_finalize, NULL, &value, &copied));
+  NAPI_ASSERT(env, copied, "Buffer over the budget was not copied");
+  NAPI_ASSERT(env, external_finalize_count == 1,
+      "Buffer over the budget was not finalized");
+
+  // eviction: a buffer filling the budget pushes out the first entry
+  // with both of its owners
+  NAPI_CALL(env, node_api_create_external_string_latin1(
+      env, large, budget - 1, NULL, NULL, &value, &copied));
+  NAPI_ASSERT(env, external_finalize_count == 3,
+      "Eviction did not run both finalizers");
+  free(large);
+
+  NAPI_CALL(env, napi_get_boolean(env, true, &result));
+  return result;
+}
+#endif
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor properties[] = {
@@ -463,6 +630,12 @@ napi_value Init(napi_env env, napi_value exports) {
       DECLARE_NAPI_PROPERTY("TestMemoryCorruption", TestMemoryCorruption),
       DECLARE_NAPI_PROPERTY("TestUtf8Large", TestUtf8Large),
       DECLARE_NAPI_PROPERTY("TestUtf16Large", TestUtf16Large),
+      DECLARE_NAPI_PROPERTY("TestLengthAfterScopeClose", TestLengthAfterScopeClose),
+#ifdef __wasm__
+      DECLARE_NAPI_PROPERTY("TestCopyStrings", CopyStrings),
+      DECLARE_NAPI_PROPERTY("TestAfterGrowMemory", TestAfterGrowMemory),
+      DECLARE_NAPI_PROPERTY("TestExternalStringCache", TestExternalStringCache),
+#endif
   };
 
   init_test_null(env, exports);
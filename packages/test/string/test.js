@@ -129,4 +129,23 @@ module.exports = function test (test_string) {
   test_string.TestMemoryCorruption(' '.repeat(64 * 1024))
   assert.strictEqual(test_string.TestUtf8Large(), 'a'.repeat(256 * 1024 * 1024))
   assert.strictEqual(test_string.TestUtf16Large(), '慡'.repeat(64 * 1024 * 1024))
+
+  {
+    const short = 'é'.repeat(300)
+    const long = '中'.repeat(400)
+    assert.strictEqual(test_string.TestLengthAfterScopeClose(short, long), long)
+    assert.strictEqual(test_string.TestLengthAfterScopeClose(long, short), short)
+  }
+
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    for (const str of ['', 'ascii', '中文 😀', JSON.stringify({ key: 'é'.repeat(300) }), '\uD800x'.repeat(100)]) {
+      const expected = Buffer.from(str).toString()
+      assert.deepStrictEqual(test_string.TestCopyStrings(str), [expected, expected])
+    }
+
+    // memory grown by malloc in C is noticed by the next string call
+    assert.strictEqual(test_string.TestAfterGrowMemory('grown 中文'), 'grown 中文')
+
+    assert.strictEqual(test_string.TestExternalStringCache(), true)
+  }
 }
@@ -0,0 +1,27 @@
+'use strict'
+const assert = require('assert')
+const fs = require('fs')
+const path = require('path')
+
+// checks the output of the macro transformer in the built core library
+function getFunctionSource (code, name) {
+  const start = code.search(new RegExp(`function ${name}\\s*\\(`))
+  assert.notStrictEqual(start, -1, `${name} not found`)
+  const end = code.indexOf('\nfunction ', start + 1)
+  return code.slice(start, end === -1 ? undefined : end)
+}
+
+module.exports = new Promise((resolve) => {
+  const code = fs.readFileSync(path.join(__dirname, '../../emnapi/dist/emnapi-core.js'), 'utf8')
+
+  // cannot call into JS, so the body runs without try/catch
+  const strictEquals = getFunctionSource(code, 'napi_strict_equals')
+  assert.ok(strictEquals.includes('clearLastError'), 'napi_strict_equals has no preamble')
+  assert.ok(!/\btry\b/.test(strictEquals), 'napi_strict_equals keeps the try/catch')
+
+  // calls user JS, so it keeps the try/catch
+  const callFunction = getFunctionSource(code, 'napi_call_function')
+  assert.ok(/\btry\b/.test(callFunction), 'napi_call_function lost the try/catch')
+
+  resolve()
+})